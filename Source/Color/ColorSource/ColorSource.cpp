@@ -83,8 +83,9 @@ void ColorSource::inspectableDestroyed(Inspectable* i)
 
 Colour ColorSource::getLinkedColor(ColorParameter* p, Object* o, int id, float originalTime)
 {
-	var cVar = GetSourceLinkedValue(p);
-	return Colour::fromFloatRGBA(cVar[0], cVar[1], cVar[2], cVar[3]);
+	float c[4] = { 0, 0, 0, 1 };
+	sourceParams.getLinkedValues(p, o, id, originalTime, c, 4);
+	return Colour::fromFloatRGBA(c[0], c[1], c[2], c[3]);
 }
 
 String ColorSource::getSourceLabel() const
@@ -180,6 +181,12 @@ float TimedColorSource::getCurrentTime(float timeOverride)
 	return timeOverride >= 0 ? timeOverride * speed->floatValue() : curTime;
 }
 
+bool TimedColorSource::isTimeDependent()
+{
+	if (sourceTemplate != nullptr && !sourceTemplateRef.wasObjectDeleted()) return sourceTemplate->isTimeDependent();
+	return speed->floatValue() != 0;
+}
+
 void TimedColorSource::hiResTimerCallback()
 {
 	addTime();
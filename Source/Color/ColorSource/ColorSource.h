@@ -48,6 +48,7 @@ public:
 	Colour getLinkedColor(ColorParameter* p, Object* o, int id, float time);
 
 	virtual ColorParameter* getMainColorParameter() { return nullptr; }
+	virtual bool isTimeDependent() { return false; }
 
 
 	class  ColorSourceListener
@@ -92,6 +93,7 @@ public:
 	virtual void fillColorsForObjectTimeInternal(Array<Colour, CriticalSection>& colors, Object* o, ColorComponent* c, int id, float time, float originalTime) { }
 
 	virtual float getCurrentTime(float timeOverride = -1);
+	virtual bool isTimeDependent() override;
 
 	virtual void addTime();
 
@@ -10,6 +10,126 @@
 
 #include "Color/ColorIncludes.h"
 
+//Batch kernels for the pattern sources. Linked values are resolved once per call by the sources,
+//per-pixel values are computed into float planes (vectorised with FloatVectorOperations where possible)
+//and the results are written straight into the locked colour array.
+//Planes 0 to 4 are used by the kernels, plane 5 is left for the sources' inputs.
+namespace PatternKernels
+{
+	static float* getPlane(int plane, int size)
+	{
+		thread_local HeapBlock<float> planes[6];
+		thread_local int planeSizes[6] = { 0, 0, 0, 0, 0, 0 };
+		if (planeSizes[plane] < size)
+		{
+			planes[plane].allocate(size, false);
+			planeSizes[plane] = size;
+		}
+		return planes[plane].get();
+	}
+
+	static void fillRamp(float* dest, int num, float start, float step)
+	{
+		for (int i = 0; i < num; i++) dest[i] = start + i * step;
+	}
+
+	static inline uint8 toByte(float v)
+	{
+		return (uint8)roundToInt(jlimit(0.f, 1.f, v) * 255);
+	}
+
+	//Same as withMultipliedBrightness, without the HSB round trip : scaling all channels keeps hue and saturation
+	static inline void scaleBrightness(float& r, float& g, float& b, float brightness)
+	{
+		float maxC = jmax(r, g, b);
+		float scale = maxC > 0 ? jmin(maxC * brightness, 1.f) / maxC : 0;
+		r *= scale;
+		g *= scale;
+		b *= scale;
+	}
+
+	//Same as Colour::fromHSV for each hue, hues don't need to be wrapped
+	static void fillHSV(Colour* dest, const float* hues, int num, float saturation, float brightness)
+	{
+		const float s = jlimit(0.f, 1.f, saturation);
+		const float v = jlimit(0.f, 1.f, brightness);
+		const uint8 vb = toByte(v);
+
+		for (int i = 0; i < num; i++)
+		{
+			float h = (hues[i] - std::floor(hues[i])) * 6.0f;
+			int sector = (int)h;
+			float f = h - sector;
+			uint8 x = toByte(v * (1.0f - s));
+			uint8 y = toByte(v * (1.0f - s * f));
+			uint8 z = toByte(v * (1.0f - s * (1.0f - f)));
+
+			switch (sector)
+			{
+			case 0: dest[i] = Colour(vb, z, x); break;
+			case 1: dest[i] = Colour(y, vb, x); break;
+			case 2: dest[i] = Colour(x, vb, z); break;
+			case 3: dest[i] = Colour(x, y, vb); break;
+			case 4: dest[i] = Colour(z, x, vb); break;
+			default: dest[i] = Colour(vb, x, y); break;
+			}
+		}
+	}
+
+	//Same as from.interpolatedWith(to, proportion).withMultipliedBrightness(brightness) for each proportion :
+	//like JUCE, colours are blended premultiplied then unpremultiplied, and proportions outside ]0, 1[ give the end colours as is.
+	//If skipNegative is set, pixels with a negative proportion are left untouched.
+	static void fillBlend(Colour* dest, const float* proportions, int num, Colour from, Colour to, float brightness, bool skipNegative = false)
+	{
+		float* t = getPlane(4, num);
+		FloatVectorOperations::clip(t, proportions, 0, 1, num);
+
+		const float fromC[4] = { from.getFloatRed(), from.getFloatGreen(), from.getFloatBlue(), from.getFloatAlpha() };
+		const float toC[4] = { to.getFloatRed(), to.getFloatGreen(), to.getFloatBlue(), to.getFloatAlpha() };
+		const float fromP[4] = { fromC[0] * fromC[3], fromC[1] * fromC[3], fromC[2] * fromC[3], fromC[3] };
+		const float toP[4] = { toC[0] * toC[3], toC[1] * toC[3], toC[2] * toC[3], toC[3] };
+		float* planes[4] = { getPlane(0, num), getPlane(1, num), getPlane(2, num), getPlane(3, num) };
+
+		for (int c = 0; c < 4; c++)
+		{
+			FloatVectorOperations::copyWithMultiply(planes[c], t, toP[c] - fromP[c], num);
+			FloatVectorOperations::add(planes[c], fromP[c], num);
+		}
+
+		for (int i = 0; i < num; i++)
+		{
+			if (skipNegative && proportions[i] < 0) continue;
+
+			float r, g, b, a;
+			if (t[i] <= 0 || t[i] >= 1)
+			{
+				const float* c = t[i] <= 0 ? fromC : toC;
+				r = c[0]; g = c[1]; b = c[2]; a = c[3];
+			}
+			else
+			{
+				a = planes[3][i];
+				float invA = a > 0 ? 1 / a : 0;
+				r = planes[0][i] * invA; g = planes[1][i] * invA; b = planes[2][i] * invA;
+			}
+
+			scaleBrightness(r, g, b, brightness);
+			dest[i] = Colour(toByte(r), toByte(g), toByte(b), toByte(a));
+		}
+	}
+
+	static void multiplyBrightness(Colour* dest, int num, float brightness)
+	{
+		if (brightness == 1) return;
+		for (int i = 0; i < num; i++)
+		{
+			float r = dest[i].getFloatRed(), g = dest[i].getFloatGreen(), b = dest[i].getFloatBlue();
+			scaleBrightness(r, g, b, brightness);
+			dest[i] = Colour(toByte(r), toByte(g), toByte(b), dest[i].getAlpha());
+		}
+	}
+}
+
 SolidColorSource::SolidColorSource(var params) :
 	TimedColorSource(getTypeString(), params)
 {
@@ -45,12 +165,18 @@ RainbowColorSource::~RainbowColorSource()
 
 void RainbowColorSource::fillColorsForObjectTimeInternal(Array<Colour, CriticalSection>& colors, Object* o, ColorComponent* comp, int id, float time, float originalTime)
 {
-	int resolution = colors.size();
-	for (int i = 0; i < resolution; i++)
-	{
-		double rel = fmodf((1 - (i * 1.0f / resolution)) * (double)GetSourceLinkedValue(density) + time, 1);
-		colors.set(i, Colour::fromHSV(rel, (double)GetSourceLinkedValue(saturation), (double)GetSourceLinkedValue(brightness), 1));
-	}
+	const int resolution = colors.size();
+	if (resolution == 0) return;
+
+	float densityVal = GetSourceLinkedValue(density);
+	float saturationVal = GetSourceLinkedValue(saturation);
+	float brightnessVal = GetSourceLinkedValue(brightness);
+
+	float* hues = PatternKernels::getPlane(5, resolution);
+	PatternKernels::fillRamp(hues, resolution, densityVal + time, -densityVal / resolution);
+
+	GenericScopedLock lock(colors.getLock());
+	PatternKernels::fillHSV(colors.getRawDataPointer(), hues, resolution, saturationVal, brightnessVal);
 }
 
 //---------------------
@@ -97,12 +223,22 @@ void NoiseColorSource::fillColorsForObjectTimeInternal(Array<Colour, CriticalSec
 	Colour bColor = GetLinkedColor(bgColor);
 	Colour fColor = GetLinkedColor(frontColor);
 
-	int resolution = colors.size();
+	const int resolution = colors.size();
+	if (resolution == 0) return;
+
+	double scaleVal = GetSourceLinkedValue(scale);
+	double contrastVal = GetSourceLinkedValue(contrast);
+	double balanceVal = GetSourceLinkedValue(balance);
+	float brightnessVal = GetSourceLinkedValue(brightness);
+
+	float* values = PatternKernels::getPlane(5, resolution);
 	for (int i = 0; i < resolution; i++)
 	{
-		double v = (perlin->noise0_1((i * (double)GetSourceLinkedValue(scale)) / resolution, time) - .5f) * (double)GetSourceLinkedValue(contrast) + .5f + (double)GetSourceLinkedValue(balance) * 2;
-		colors.set(i, bColor.interpolatedWith(fColor, v).withMultipliedBrightness((double)GetSourceLinkedValue(brightness)));
+		values[i] = (perlin->noise0_1((i * scaleVal) / resolution, time) - .5f) * contrastVal + .5f + balanceVal * 2;
 	}
+
+	GenericScopedLock lock(colors.getLock());
+	PatternKernels::fillBlend(colors.getRawDataPointer(), values, resolution, bColor, fColor, brightnessVal);
 }
 
 
@@ -145,14 +281,30 @@ void PointColorSource::fillColorsForObjectInternal(Array<Colour, CriticalSection
 
 	colors.fill(bColor);
 
-	for (int i = relStart; i <= relEnd && i < resolution; i++)
-	{
-		double diff = 1 - (fabsf(i - relPos) * 1.f / (relSize / ((double)GetSourceLinkedValue(fade) * 2 * extendVal)));
+	int start = (int)relStart;
+	int end = jmin<int>(relEnd, resolution - 1);
+	if (end < start) return;
 
-		bool invert = id % 2 == 0 ? GetSourceLinkedValue(invertEvens) : GetSourceLinkedValue(invertOdds);
-		Colour c = bColor.interpolatedWith(pColor, diff);
-		colors.set(invert ? resolution - i : i, c.withMultipliedBrightness((double)GetSourceLinkedValue(brightness)));
+	double fadeVal = GetSourceLinkedValue(fade);
+	float brightnessVal = GetSourceLinkedValue(brightness);
+	bool invert = id % 2 == 0 ? GetSourceLinkedValue(invertEvens) : GetSourceLinkedValue(invertOdds);
+	double fadeSize = relSize / (fadeVal * 2 * extendVal);
+
+	//inverted pixels land at resolution - i, so fill that range in destination order and drop the one falling out of the array
+	int destStart = invert ? resolution - end : start;
+	int destEnd = invert ? jmin(resolution - start, resolution - 1) : end;
+	int num = destEnd - destStart + 1;
+	if (num <= 0) return;
+
+	float* diffs = PatternKernels::getPlane(5, num);
+	for (int j = 0; j < num; j++)
+	{
+		int i = invert ? resolution - (destStart + j) : destStart + j;
+		diffs[j] = 1 - (fabsf(i - relPos) * 1.f / fadeSize);
 	}
+
+	GenericScopedLock lock(colors.getLock());
+	PatternKernels::fillBlend(colors.getRawDataPointer() + destStart, diffs, num, bColor, pColor, brightnessVal);
 }
 
 
@@ -188,19 +340,23 @@ void MultiPointColorSource::fillColorsForObjectTimeInternal(Array<Colour, Critic
 	double targetPos = time;
 	if (targetPos < 0) targetPos = fmodf(targetPos, -gapVal) + gapVal;
 
+	double sizeVal = GetSourceLinkedValue(size);
+	double fadeVal = GetSourceLinkedValue(fade);
+	float brightnessVal = GetSourceLinkedValue(brightness);
+
+	//pixels outside of a point get a negative value and keep the background color
+	float* values = PatternKernels::getPlane(5, resolution);
 	for (int i = 0; i < resolution; i++)
 	{
 		double relTotal = fmodf((1 - (i * 1.0f / resolution)), 1);
 		double relGap = fmodf((relTotal + gapVal + targetPos) / gapVal, 1);
-		double relCentered = 1 - fabsf((relGap - .5f) * 2) * 1 / (double)GetSourceLinkedValue(size);
+		double relCentered = 1 - fabsf((relGap - .5f) * 2) * 1 / sizeVal;
 
-		if (relCentered < 0) continue;
-
-		double relFadedVal = jmap<double>(jlimit<double>(0, 1, relCentered), 1 - (double)GetSourceLinkedValue(fade), 1);
-
-		Colour c = bColor.interpolatedWith(pColor, relFadedVal);
-		colors.set(i, c.withMultipliedBrightness((double)GetSourceLinkedValue(brightness)));
+		values[i] = relCentered < 0 ? -1 : jmap<double>(jlimit<double>(0, 1, relCentered), 1 - fadeVal, 1);
 	}
+
+	GenericScopedLock lock(colors.getLock());
+	PatternKernels::fillBlend(colors.getRawDataPointer(), values, resolution, bColor, pColor, brightnessVal, true);
 }
 
 GradientColorSource::GradientColorSource(var params) :
@@ -243,13 +399,21 @@ void GradientColorSource::linkToTemplate(ColorSource* sourceTemplate)
 void GradientColorSource::fillColorsForObjectTimeInternal(Array<Colour, CriticalSection>& colors, Object* o, ColorComponent* comp, int id, float time, float originalTime)
 {
 	const int resolution = colors.size();
+	if (resolution == 0) return;
 
+	double densityVal = GetSourceLinkedValue(density);
+	float brightnessVal = GetSourceLinkedValue(brightness);
+
+	GenericScopedLock lock(colors.getLock());
+	Colour* dest = colors.getRawDataPointer();
 	for (int i = 0; i < resolution; i++)
 	{
-		double p = fmodf(time + i * (double)GetSourceLinkedValue(density) / resolution, 1);
+		double p = fmodf(time + i * densityVal / resolution, 1);
 		if (p < 0) p++;
-		colors.set(i, gradientTarget->getColorForPosition(p).withMultipliedBrightness((double)GetSourceLinkedValue(brightness)));
+		dest[i] = gradientTarget->getColorForPosition(p);
 	}
+
+	PatternKernels::multiplyBrightness(dest, resolution, brightnessVal);
 }
 
 void GradientColorSource::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
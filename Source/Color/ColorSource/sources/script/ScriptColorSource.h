@@ -20,6 +20,7 @@ public:
     //NodeManager nodeManager;
 
     virtual void fillColorsForObjectTimeInternal(Array<Colour, CriticalSection>& colors, Object* o, ColorComponent* comp, int id, float time, float originalTime) override;
+    bool isTimeDependent() override { return true; }
 
     String getTypeString() const override { return "Script"; }
     static ScriptColorSource* create(var params) { return new ScriptColorSource(params); }
@@ -23,6 +23,7 @@ public:
 
     Image sourceImage;
 
+    bool isTimeDependent() override { return true; } //image content can change at any time
     virtual void fillColorsForObjectTimeInternal(Array<Colour, CriticalSection>& colors, Object* o, ColorComponent* comp, int id, float time, float originalTime) override;
 };
 
@@ -36,6 +36,8 @@
 
 #include "Zeroconf/ZeroconfManager.cpp"
 
+#include "Serial/lib/cobs/cobs.cpp"
+
 #include "Spatializer/SpatItem.cpp"
 #include "Spatializer/SpatManager.cpp"
 #include "Spatializer/ui/SpatItemViewUI.cpp"
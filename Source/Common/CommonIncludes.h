@@ -41,5 +41,7 @@
 
 #include "Zeroconf/ZeroconfManager.h"
 
+#include "Serial/lib/cobs/cobs.h"
+
 
 
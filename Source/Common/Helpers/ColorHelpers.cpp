@@ -129,96 +129,125 @@ void ColorHelpers::init()
 
 Colour ColorHelpers::getColorForTemperature(float temperature)
 {
-	if (temperatureColorMap.size() == 0)
-		init();
+	//called from the update workers, the static initialization runs init() once and makes other threads wait until the map is complete
+	static const HashMap<int, Colour>& colorMap = []() -> const HashMap<int, Colour>& { init(); return temperatureColorMap; }();
 
 	int temp = jlimit<int>(1000, 12000, temperature);
 	temp = roundToInt(temp / 100) * 100;
 
 	// Constructor
 	//
-	return temperatureColorMap[temp];
+	return colorMap[temp];
 }
 
 var ColorHelpers::getRGBWFromRGB(Colour col, float temperature)
 {
-	Colour tempColor = getColorForTemperature(temperature);
-
-	float r = col.getFloatRed();
-	float g = col.getFloatGreen();
-	float b = col.getFloatBlue();
-
-	float tempRed = tempColor.getFloatRed();
-	float tempGreen = tempColor.getFloatGreen();
-	float tempBlue = tempColor.getFloatBlue();
-
-	// Calculate all of the color's white values corrected taking into account the white color temperature.
-	float wRed = r / tempRed;
-	float wGreen = g / tempGreen;
-	float wBlue = b / tempBlue;
+	WhitePoint wp = getWhitePoint(temperature);
+	float c[5];
+	convertToRGBW(&col, 1, wp, c, 5);
 
-	// Determine the smallest white value from above.
-	float wMin = jmin(wRed, wGreen, wBlue);
-
-	// Make the color with the smallest white value to be the output white value
-	float wOut;
-	if (wMin == wRed)
-		wOut = r;
-	else if (wMin == wGreen)
-		wOut = g;
-	else
-		wOut = b;
+	var result;
+	for (int i = 0; i < 5; i++) result.append(c[i]);
+	return result;
+}
 
-	// Calculate the output red, green and blue values, taking into account the white color temperature.
-	float rOut = r - wOut * tempRed;
-	float gOut = g - wOut * tempGreen;
-	float bOut = b - wOut * tempBlue;
+var ColorHelpers::getRGBWAFromRGB(Colour col, float temperature)
+{
+	WhitePoint wp = getWhitePoint(temperature);
+	float c[5];
+	convertToRGBWA(&col, 1, wp, c, 5);
 
 	var result;
-	result.append(rOut);
-	result.append(gOut);
-	result.append(bOut);
-	result.append(wOut);
-	result.append(0);
-
+	for (int i = 0; i < 5; i++) result.append(c[i]);
 	return result;
 }
 
-var ColorHelpers::getRGBWAFromRGB(Colour col, float temperature)
+ColorHelpers::WhitePoint ColorHelpers::getWhitePoint(float temperature)
 {
 	Colour tempColor = getColorForTemperature(temperature);
 
-	float r = col.getFloatRed();
-	float g = col.getFloatGreen();
-	float b = col.getFloatBlue();
-
-	float tempRed = tempColor.getFloatRed();
-	float tempGreen = tempColor.getFloatGreen();
-	float tempBlue = tempColor.getFloatBlue();
+	WhitePoint wp;
+	wp.r = tempColor.getFloatRed();
+	wp.g = tempColor.getFloatGreen();
+	wp.b = tempColor.getFloatBlue();
+	wp.invR = 1.0f / wp.r;
+	wp.invG = 1.0f / wp.g;
+	wp.invB = 1.0f / wp.b;
 
-	// Calculate all of the color's white values corrected taking into account the white color temperature.
-	float wRed = r / tempRed;
-	float wGreen = g / tempGreen;
-	float wBlue = b / tempBlue;
+	return wp;
+}
 
-	float wOut = jmin(wRed, wGreen, wBlue);
+void ColorHelpers::convertToRGB(const Colour* colors, int numColors, float* dest, int stride)
+{
+	for (int i = 0; i < numColors; i++, dest += stride)
+	{
+		dest[0] = colors[i].getFloatRed();
+		dest[1] = colors[i].getFloatGreen();
+		dest[2] = colors[i].getFloatBlue();
+	}
+}
 
-	float wr = r - wOut * tempRed;
-	float wg = g - wOut * tempGreen;
-	float wb = b - wOut * tempBlue;
+void ColorHelpers::convertToRGBW(const Colour* colors, int numColors, const WhitePoint& wp, float* dest, int stride)
+{
+	for (int i = 0; i < numColors; i++, dest += stride)
+	{
+		float r = colors[i].getFloatRed();
+		float g = colors[i].getFloatGreen();
+		float b = colors[i].getFloatBlue();
+
+		// Calculate all of the color's white values corrected taking into account the white color temperature.
+		float wRed = r * wp.invR;
+		float wGreen = g * wp.invG;
+		float wBlue = b * wp.invB;
+
+		// Make the color with the smallest white value to be the output white value
+		float wMin = jmin(wRed, wGreen, wBlue);
+		float wOut = wMin == wRed ? r : (wMin == wGreen ? g : b);
+
+		// Calculate the output red, green and blue values, taking into account the white color temperature.
+		dest[0] = r - wOut * wp.r;
+		dest[1] = g - wOut * wp.g;
+		dest[2] = b - wOut * wp.b;
+		dest[3] = wOut;
+		dest[4] = 0;
+	}
+}
 
-	float aOut = wr;
-	if (aOut > wg * 2) aOut = wg * 2;
-	float rOut = wr - aOut;
-	float gOut = wg - aOut / 2;
-	float bOut = wb;
+void ColorHelpers::convertToRGBWA(const Colour* colors, int numColors, const WhitePoint& wp, float* dest, int stride)
+{
+	for (int i = 0; i < numColors; i++, dest += stride)
+	{
+		float r = colors[i].getFloatRed();
+		float g = colors[i].getFloatGreen();
+		float b = colors[i].getFloatBlue();
+
+		float wOut = jmin(r * wp.invR, g * wp.invG, b * wp.invB);
+
+		float wr = r - wOut * wp.r;
+		float wg = g - wOut * wp.g;
+		float wb = b - wOut * wp.b;
+
+		float aOut = jmin(wr, wg * 2);
+
+		dest[0] = wr - aOut;
+		dest[1] = wg - aOut / 2;
+		dest[2] = wb;
+		dest[3] = wOut;
+		dest[4] = aOut;
+	}
+}
 
-	var result;
-	result.append(rOut);
-	result.append(gOut);
-	result.append(bOut);
-	result.append(wOut);
-	result.append(aOut);
+void ColorHelpers::convertToCMY(const Colour* colors, int numColors, float* dest, int stride)
+{
+	for (int i = 0; i < numColors; i++, dest += stride)
+	{
+		dest[0] = 1 - colors[i].getFloatRed();
+		dest[1] = 1 - colors[i].getFloatGreen();
+		dest[2] = 1 - colors[i].getFloatBlue();
+	}
+}
 
-	return result;
+void ColorHelpers::convertToHS(const Colour* colors, int numColors, float* dest, int stride)
+{
+	for (int i = 0; i < numColors; i++, dest += stride) colors[i].getHSB(dest[0], dest[1], dest[2]);
 }
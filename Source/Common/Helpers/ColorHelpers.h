@@ -20,4 +20,22 @@ public:
 
     static var getRGBWFromRGB(Colour val, float temperature);
     static var getRGBWAFromRGB(Colour val, float temperature);
+
+    //White point constants for a temperature, to resolve once per frame instead of once per pixel
+    struct WhitePoint
+    {
+        float r, g, b;
+        float invR, invG, invB;
+    };
+
+    static WhitePoint getWhitePoint(float temperature);
+
+    //Batch conversions, dest receives stride floats per colour
+    static void convertToRGB(const Colour* colors, int numColors, float* dest, int stride);
+    static void convertToRGBW(const Colour* colors, int numColors, const WhitePoint& wp, float* dest, int stride);
+    static void convertToRGBWA(const Colour* colors, int numColors, const WhitePoint& wp, float* dest, int stride);
+    static void convertToCMY(const Colour* colors, int numColors, float* dest, int stride);
+    static void convertToHS(const Colour* colors, int numColors, float* dest, int stride);
+
+    static inline uint8 toDMXValue(float value) { return (uint8)jlimit<int>(0, 255, roundToInt(value * 255)); }
 };
\ No newline at end of file
@@ -9,6 +9,8 @@
 */
 #include "Common/CommonIncludes.h"
 
+static thread_local SceneHelpers::LerpPlan* compilingLerpPlan = nullptr;
+
 var SceneHelpers::getParamsSceneData(ControllableContainer* container, Array<Parameter*> excludeParams, bool recursive)
 {
 	var data(new DynamicObject());
@@ -50,10 +52,19 @@ void SceneHelpers::lerpSceneParams(ControllableContainer* container, var startDa
 
 void SceneHelpers::lerpSceneParam(ControllableContainer* container, Parameter* p, var startData, var endData, float weight)
 {
-	var val = var();
 	String addr = p->getControlAddress(container);
-	var startValue = startData.getProperty(addr, p->defaultValue);
-	var endValue = endData.getProperty(addr, p->defaultValue);
+	lerpParamValue(p, startData.getProperty(addr, p->defaultValue), endData.getProperty(addr, p->defaultValue), weight);
+}
+
+void SceneHelpers::lerpParamValue(Parameter* p, var startValue, var endValue, float weight)
+{
+	if (compilingLerpPlan != nullptr)
+	{
+		compilingLerpPlan->entries.add({ p, startValue, endValue });
+		return;
+	}
+
+	var val = var();
 
 	if (p->value.isArray())
 	{
@@ -73,3 +84,24 @@ void SceneHelpers::lerpSceneParam(ControllableContainer* container, Parameter* p
 
 	p->setValue(val);
 }
+
+void SceneHelpers::beginLerpPlan(LerpPlan* plan)
+{
+	jassert(compilingLerpPlan == nullptr);
+	plan->entries.clearQuick();
+	compilingLerpPlan = plan;
+}
+
+void SceneHelpers::endLerpPlan()
+{
+	compilingLerpPlan = nullptr;
+}
+
+void SceneHelpers::LerpPlan::lerp(float weight)
+{
+	for (auto& e : entries)
+	{
+		if (e.param == nullptr || e.param.wasObjectDeleted()) continue;
+		lerpParamValue(e.param, e.startValue, e.endValue, weight);
+	}
+}
\ No newline at end of file
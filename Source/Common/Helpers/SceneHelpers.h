@@ -16,5 +16,25 @@ public:
     static var getParamsSceneData(ControllableContainer * i, Array<Parameter *> excludeParams = Array<Parameter *>(), bool recursive = false);
     static void lerpSceneParams(ControllableContainer * i, var startData, var endData, float weight, bool recursive = false);
     static void lerpSceneParam(ControllableContainer* container, Parameter * p, var startData, var endData, float weight);
+    static void lerpParamValue(Parameter* p, var startValue, var endValue, float weight);
 
+    //Resolved list of parameters to lerp for a scene load, so addresses and containers are only walked once per load
+    class LerpPlan
+    {
+    public:
+        struct Entry
+        {
+            WeakReference<Parameter> param;
+            var startValue;
+            var endValue;
+        };
+
+        Array<Entry> entries;
+
+        void lerp(float weight);
+    };
+
+    //While a plan is being compiled, lerpSceneParam and lerpParamValue add entries to it on the calling thread instead of setting values
+    static void beginLerpPlan(LerpPlan* plan);
+    static void endLerpPlan();
 };
\ No newline at end of file
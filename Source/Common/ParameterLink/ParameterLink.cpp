@@ -10,6 +10,8 @@
 #include "Common/CommonIncludes.h"
 #include "Object/ObjectIncludes.h"
 
+Atomic<int> ParameterLink::sourceVersion;
+
 ParameterLink::ParameterLink(WeakReference<Parameter> p) :
 	linkType(NONE),
 	parameter(p),
@@ -132,7 +134,166 @@ var ParameterLink::getLinkedValue(Object* o, int id)
 	return parameter->getValue();
 }
 
+bool ParameterLink::isResolvedPerObject() const
+{
+	switch (linkType)
+	{
+	case CUSTOM_PARAM:
+	case OBJECT_POSXZ:
+	case OBJECT_POSXYZ:
+	case SPAT_X:
+	case SPAT_Z:
+	case SPAT_XZ:
+		return true;
+
+	default:
+		break;
+	}
 
+	return false;
+}
+
+bool ParameterLink::getResolvedValue(Object* o, ResolvedValue& dest)
+{
+	const int version = sourceVersion.get();
+	ResolvedSlot* slot = getResolvedSlot(o);
+
+	if (slot->version.get() == version)
+	{
+		dest = slot->value;
+		return true;
+	}
+
+	if (!resolveValue(o, dest)) return false; //fallbacks are never stored, they follow the parameter value
+
+	slot->version = -1;
+	slot->value = dest;
+	slot->version = version; //if sources changed while resolving, the slot is already stale
+	return true;
+}
+
+bool ParameterLink::resolveValue(Object* o, ResolvedValue& dest)
+{
+	switch (linkType)
+	{
+	case CUSTOM_PARAM:
+		if (linkedCustomParam == nullptr || linkedCustomParam.wasObjectDeleted()) return false;
+		return dest.compile(o->customParams->getParamValueFor(linkedCustomParam));
+
+	case OBJECT_POSXZ:
+	case OBJECT_POSXYZ:
+	{
+		const int numValues = jlimit(1, linkType == OBJECT_POSXZ ? 2 : 3, parameter->value.size());
+		dest.type = ResolvedValue::ARRAY;
+		dest.numValues = numValues;
+		dest.values[0] = o->stagePosition->x;
+		if (linkType == OBJECT_POSXZ)
+		{
+			if (numValues > 1) dest.values[1] = o->stagePosition->z;
+		}
+		else
+		{
+			if (numValues > 1) dest.values[1] = o->stagePosition->y;
+			if (numValues > 2) dest.values[2] = o->stagePosition->z;
+		}
+		return true;
+	}
+
+	case SPAT_X:
+	case SPAT_Z:
+	case SPAT_XZ:
+	{
+		if (spatializer == nullptr || spatRef.wasObjectDeleted()) return false;
+		Point<float> relPos = spatializer->getObjectPosition(o);
+		if (linkType == SPAT_XZ)
+		{
+			dest.type = ResolvedValue::ARRAY;
+			dest.numValues = parameter->value.size() > 1 ? 2 : 1;
+			dest.values[0] = relPos.x;
+			dest.values[1] = relPos.y;
+		}
+		else
+		{
+			dest.type = ResolvedValue::FLOAT;
+			dest.numValues = 1;
+			dest.values[0] = linkType == SPAT_X ? relPos.x : relPos.y;
+		}
+		return true;
+	}
+
+	default:
+		break;
+	}
+
+	return false;
+}
+
+ParameterLink::ResolvedSlot* ParameterLink::getResolvedSlot(Object* o)
+{
+	ResolvedBlock* block = resolvedBlock.get();
+	if (block != nullptr && o->stateIndex < block->size) return &block->slots[o->stateIndex];
+
+	GenericScopedLock lock(resolvedBlockLock);
+	block = resolvedBlock.get();
+	if (block == nullptr || o->stateIndex >= block->size)
+	{
+		//slots of the old block are not copied, they will just be resolved again
+		block = resolvedBlocks.add(new ResolvedBlock(jmax(16, o->stateIndex + 1, block != nullptr ? block->size * 2 : 0)));
+		resolvedBlock = block;
+	}
+
+	return &block->slots[o->stateIndex];
+}
+
+bool ParameterLink::ResolvedValue::compile(const var& value)
+{
+	type = NOT_NUMERIC;
+	numValues = 0;
+
+	if (value.isBool()) type = BOOL;
+	else if (value.isInt() || value.isInt64()) type = INT;
+	else if (value.isDouble()) type = FLOAT;
+	else if (value.isArray())
+	{
+		if (value.size() == 0 || value.size() > 4) return false;
+		for (int i = 0; i < value.size(); i++)
+		{
+			if (!value[i].isDouble() && !value[i].isInt() && !value[i].isInt64()) return false;
+			values[i] = (float)value[i];
+		}
+
+		type = ARRAY;
+		numValues = value.size();
+		return true;
+	}
+	else return false;
+
+	values[0] = (float)value;
+	numValues = 1;
+	return true;
+}
+
+var ParameterLink::ResolvedValue::getValue() const
+{
+	switch (type)
+	{
+	case FLOAT: return values[0];
+	case INT: return (int)values[0];
+	case BOOL: return values[0] != 0;
+	case ARRAY:
+	{
+		Array<var> result;
+		result.ensureStorageAllocated(numValues);
+		for (int i = 0; i < numValues; i++) result.add(values[i]);
+		return result;
+	}
+
+	default:
+		break;
+	}
+
+	return var();
+}
 
 
 
@@ -270,6 +431,7 @@ void ParameterLink::itemRemoved(SpatItem* item)
 		spatGhostName = spatializer->shortName;
 		spatializer = nullptr;
 		spatRef = nullptr;
+		invalidateSources();
 	}
 }
 
@@ -283,6 +445,7 @@ void ParameterLink::itemsRemoved(Array<SpatItem*> items)
 			spatGhostName = spatializer->shortName;
 			spatializer = nullptr;
 			spatRef = nullptr;
+			invalidateSources();
 			return;
 		}
 	}
@@ -290,6 +453,7 @@ void ParameterLink::itemsRemoved(Array<SpatItem*> items)
 
 void ParameterLink::notifyLinkUpdated()
 {
+	invalidateSources();
 	parameterLinkListeners.call(&ParameterLinkListener::linkUpdated, this);
 	paramLinkNotifier.addMessage(new ParameterLinkEvent(ParameterLinkEvent::PREVIEW_UPDATED, this));
 }
@@ -404,11 +568,45 @@ var ParamLinkContainer::getLinkedValue(Parameter* p, Object* o, int id, float ti
 	if (!paramsCanBeLinked) return getParamValue(p, time);
 	if (ParameterLink* pLink = getLinkedParam(p))
 	{
-		if (pLink->linkType != ParameterLink::NONE) return pLink->getLinkedValue(o, id);
+		if (pLink->linkType != ParameterLink::NONE)
+		{
+			ParameterLink::ResolvedValue rv;
+			if (o != nullptr && pLink->isResolvedPerObject() && pLink->getResolvedValue(o, rv)) return rv.getValue();
+			return pLink->getLinkedValue(o, id);
+		}
 	}
 	return getParamValue(p, time);
 }
 
+int ParamLinkContainer::getLinkedValues(Parameter* p, Object* o, int id, float time, float* dest, int maxValues)
+{
+	if (p == nullptr) return 0;
+
+	if (paramsCanBeLinked && o != nullptr)
+	{
+		ParameterLink* pLink = getLinkedParam(p);
+		ParameterLink::ResolvedValue rv;
+		if (pLink != nullptr && pLink->isResolvedPerObject() && pLink->getResolvedValue(o, rv))
+		{
+			const int numValues = jmin(rv.numValues, maxValues);
+			for (int i = 0; i < numValues; i++) dest[i] = rv.values[i];
+			return numValues;
+		}
+	}
+
+	var value = getLinkedValue(p, o, id, time);
+	if (!value.isArray())
+	{
+		if (maxValues == 0) return 0;
+		dest[0] = (float)value;
+		return 1;
+	}
+
+	const int numValues = jmin(value.size(), maxValues);
+	for (int i = 0; i < numValues; i++) dest[i] = (float)value[i];
+	return numValues;
+}
+
 var ParamLinkContainer::getParamValue(Parameter* p, float time)
 {
 	if (p->controlMode != Parameter::AUTOMATION) return p->getValue();
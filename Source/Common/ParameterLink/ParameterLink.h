@@ -25,6 +25,11 @@ public:
     LinkType linkType;
     WeakReference<Parameter> parameter;
 
+    //Changes whenever a linked value may resolve differently : link setup, object IDs and positions, custom params or spatializers.
+    //Lets users cache resolved values per object instead of resolving them every frame
+    static Atomic<int> sourceVersion;
+    static void invalidateSources() { ++sourceVersion; }
+
     SpatItem* spatializer;
     WeakReference<Inspectable> spatRef;
     String spatGhostName;
@@ -42,6 +47,45 @@ public:
 
     void setLinkedCustomParam(Parameter * p);
     var getLinkedValue(Object * o, int id);
+    bool isResolvedPerObject() const;
+
+    //Links that only depend on the object (custom params, positions, spatializers) are compiled to floats once per object,
+    //and recompiled when sourceVersion changes
+    struct ResolvedValue
+    {
+        enum ValueType { NOT_NUMERIC, FLOAT, INT, BOOL, ARRAY };
+
+        ValueType type = NOT_NUMERIC;
+        int numValues = 0;
+        float values[4];
+
+        bool compile(const var& value);
+        var getValue() const;
+    };
+
+    //One slot per object, indexed by Object::stateIndex. A slot is only written by the thread computing its object
+    struct ResolvedSlot
+    {
+        Atomic<int> version { -1 };
+        ResolvedValue value;
+    };
+
+    //Slots are read without locking, so grown blocks replace the old one atomically and old blocks are kept until the link is destroyed
+    struct ResolvedBlock
+    {
+        ResolvedBlock(int size) : size(size), slots(new ResolvedSlot[size]) {}
+        const int size;
+        std::unique_ptr<ResolvedSlot[]> slots;
+    };
+
+    Atomic<ResolvedBlock*> resolvedBlock;
+    OwnedArray<ResolvedBlock> resolvedBlocks;
+    SpinLock resolvedBlockLock; //only taken to grow
+
+    //Returns false if the value can't be resolved per object (not numeric, or missing source falling back to the parameter value)
+    bool getResolvedValue(Object* o, ResolvedValue& dest);
+    bool resolveValue(Object* o, ResolvedValue& dest);
+    ResolvedSlot* getResolvedSlot(Object* o);
 
     
 
@@ -102,6 +146,8 @@ public:
 
     virtual ParameterLink* getLinkedParam(Parameter* p);
     virtual var getLinkedValue(Parameter* p, Object * o, int id, float time = 0);
+    //Typed version for vector and color parameters, fills up to maxValues floats and returns how many were set
+    int getLinkedValues(Parameter* p, Object* o, int id, float time, float* dest, int maxValues);
 
     var getParamValue(Parameter* p, float time = 0);
 
@@ -119,6 +119,16 @@ void Effect::processComponent(Object* o, ObjectComponent* c, HashMap<Parameter*,
 
 	if (targetWeight == 0) return;
 
+	//only the component's own values are mirrored in its slots, copies made by layers and crossfades go through the table
+	bool isChainValues = &values == &c->computedValues;
+	if (isChainValues && !computePreviousValues && canProcessSlots(c))
+	{
+		processComponentSlots(o, c, targetWeight, targetID, time);
+		return;
+	}
+
+	if (isChainValues) c->syncComputedValuesFromSlots();
+
 	if (computePreviousValues)
 	{
 		if (!prevValuesMap.contains(c))
@@ -131,22 +141,24 @@ void Effect::processComponent(Object* o, ObjectComponent* c, HashMap<Parameter*,
 		}
 	}
 
-	HashMap<Parameter*, var> targetValues;
+	HashMap<Parameter*, var> targetValues(values.size() * 2 + 1); //small table, components only have a few computed params
 	processComponentInternal(o, c, values, targetValues, targetID, time);
 
+	BlendMode blendMode = mode->getValueDataAsEnum<BlendMode>();
+
 	HashMap<Parameter*, var>::Iterator it(targetValues);
 	while (it.next())
 	{
 		Parameter* cp = it.getKey();
-		var initVal = values[cp];
-		var val = it.getValue().clone();
 
-		var bVal = blendValue(initVal, val, targetWeight);
-		values.set(cp, bVal);
+		//values are owned by the computing chain, so they can be blended in place instead of rebuilt
+		blendValueInPlace(values.getReference(cp), it.getValue(), targetWeight, blendMode);
 
-		if (cp == vizComputedParamRef && vizParameter != nullptr && !vizParameter.wasObjectDeleted()) vizParameter->setValue(values[cp]);
+		if (cp == vizComputedParamRef && vizParameter != nullptr && !vizParameter.wasObjectDeleted()) o->setVizValue(vizParameter.get(), values[cp].clone());
 	}
 
+	if (isChainValues && targetValues.size() > 0) c->invalidateComputedSlots();
+
 	if (computePreviousValues)
 	{
 		HashMap<Parameter*, var>* prevVals = prevValuesMap[c];
@@ -192,6 +204,52 @@ void Effect::processComponentInternal(Object* o, ObjectComponent* c, const HashM
 
 }
 
+void Effect::processComponentSlots(Object* o, ObjectComponent* c, float targetWeight, int id, float time)
+{
+	c->syncComputedSlotsFromValues();
+
+	const int numSlots = c->numComputedSlots;
+	if (numSlots == 0) return;
+
+	thread_local HeapBlock<float> targetSlots;
+	thread_local int targetSlotsSize = 0;
+	if (targetSlotsSize < numSlots)
+	{
+		targetSlots.allocate(numSlots, false);
+		targetSlotsSize = numSlots;
+	}
+
+	float* target = targetSlots.get();
+	std::fill(target, target + numSlots, std::numeric_limits<float>::quiet_NaN());
+
+	float* slots = c->computedSlots.getRawDataPointer();
+	processComponentSlotsInternal(o, c, slots, target, id, time);
+
+	BlendMode blendMode = mode->getValueDataAsEnum<BlendMode>();
+	bool changed = false;
+	for (int i = 0; i < numSlots; i++)
+	{
+		if (std::isnan(target[i])) continue;
+		slots[i] = blendFloatValue(slots[i], target[i], targetWeight, blendMode);
+		changed = true;
+	}
+
+	if (!changed) return;
+	c->invalidateComputedValues();
+
+	if (vizComputedParamRef != nullptr && vizParameter != nullptr && !vizParameter.wasObjectDeleted())
+	{
+		if (const ObjectComponent::ComputedSlot* s = c->getComputedSlot(vizComputedParamRef.get()))
+		{
+			if (std::isnan(target[s->offset])) return;
+
+			var v;
+			ObjectComponent::writeSlotValue(*s, slots + s->offset, v);
+			o->setVizValue(vizParameter.get(), v);
+		}
+	}
+}
+
 bool Effect::isFullyEnabled()
 {
 	return enabled->boolValue() && !forceDisabled;
@@ -227,7 +285,31 @@ var Effect::blendValue(var start, var end, float weight)
 
 float Effect::blendFloatValue(float start, float end, float weight)
 {
-	BlendMode blendMode = mode->getValueDataAsEnum<BlendMode>();
+	return blendFloatValue(start, end, weight, mode->getValueDataAsEnum<BlendMode>());
+}
+
+void Effect::blendValueInPlace(var& target, const var& end, float weight, BlendMode blendMode)
+{
+	if (!target.isArray() || !end.isArray() || target.size() != end.size())
+	{
+		if (target.isArray() || end.isArray()) target = blendValue(target, end, weight); //shape mismatch, let the generic blend handle it
+		else target = blendFloatValue(target, end, weight, blendMode);
+		return;
+	}
+
+	Array<var>* tArr = target.getArray();
+	const Array<var>* eArr = end.getArray();
+	for (int i = 0; i < tArr->size(); i++)
+	{
+		var& tv = tArr->getReference(i);
+		const var& ev = eArr->getReference(i);
+		if (tv.isArray()) blendValueInPlace(tv, ev, weight, blendMode);
+		else tv = blendFloatValue(tv, ev, weight, blendMode);
+	}
+}
+
+float Effect::blendFloatValue(float start, float end, float weight, BlendMode blendMode)
+{
 	float targetVal = 0;
 	switch (blendMode)
 	{
@@ -13,6 +13,7 @@
 //helper, considering variables are name o for  Object and id for object's id
 #define GetLinkedValue(p) effectParams.getLinkedValue(p, o, id, time)
 #define GetLinkedValueT(p, time) effectParams.getLinkedValue(p, o, id, time)
+#define GetLinkedValues(p, dest) effectParams.getLinkedValues(p, o, id, time, dest, numElementsInArray(dest))
 
 
 class Effect :
@@ -41,8 +42,8 @@ public:
 	std::unique_ptr<FilterManager> filterManager;
 
 	bool computePreviousValues;
-	OwnedArray<HashMap<Parameter*, var>>  prevValues;
-	HashMap<ObjectComponent*, HashMap<Parameter*, var>*> prevValuesMap;
+	OwnedArray<HashMap<Parameter*, var>, CriticalSection>  prevValues; //locked because objects can be processed from multiple threads
+	HashMap<ObjectComponent*, HashMap<Parameter*, var>*, DefaultHashFunctions, CriticalSection> prevValuesMap;
 
 	bool forceDisabled;
 
@@ -70,11 +71,19 @@ public:
 
 	virtual bool isAffectingObject(Object* o);
 	virtual bool isAffectingObjectAndComponent(Object* o, ComponentType t);
+	virtual bool isTimeDependent() { return false; } //true if this effect may output different values without any parameter change
 	void processComponent(Object* o, ObjectComponent* c, HashMap<Parameter*, var>& values, float weightMultiplier = 1.0f, int id = -1, float time = -1);
 	virtual void processComponentInternal(Object* o, ObjectComponent* c, const HashMap<Parameter*, var>& values, HashMap<Parameter*, var>& targetValues, int id, float time = -1);
 
+	//slot path, for effects that can work on the component's float slots directly. Target slots are prefilled with NaN, only the ones written are blended
+	virtual bool canProcessSlots(ObjectComponent* c) { return false; }
+	void processComponentSlots(Object* o, ObjectComponent* c, float targetWeight, int id, float time);
+	virtual void processComponentSlotsInternal(Object* o, ObjectComponent* c, const float* slots, float* targetSlots, int id, float time = -1) {}
+
 	virtual var blendValue(var start, var end, float weight);
 	virtual float blendFloatValue(float start, float end, float weight);
+	void blendValueInPlace(var& target, const var& end, float weight, BlendMode blendMode);
+	static float blendFloatValue(float start, float end, float weight, BlendMode blendMode);
 
 	var getSceneData();
 	void updateSceneData(var& sceneData);
@@ -81,6 +81,14 @@ void EffectManager::resetEffectsTimes()
 	}
 }
 
+void EffectManager::fillTimeDependentEffects(Array<Effect*>& result)
+{
+	for (auto& e : items)
+	{
+		if (e->enabled->boolValue() && e->isTimeDependent()) result.add(e);
+	}
+}
+
 var EffectManager::getSceneData()
 {
 	var data(new DynamicObject());
@@ -95,7 +103,11 @@ void EffectManager::updateSceneData(var& sceneData)
 
 void EffectManager::lerpFromSceneData(var startData, var endData, float weight)
 {
-	if(includeWeightInScenes->boolValue()) globalWeight->setValue(jmap(weight, (float)startData, (float)endData));
+	if (includeWeightInScenes->boolValue())
+	{
+		String addr = globalWeight->getControlAddress();
+		SceneHelpers::lerpParamValue(globalWeight, startData.getProperty(addr, globalWeight->getValue()), endData.getProperty(addr, globalWeight->getValue()), weight);
+	}
 	for (auto& i : items) i->lerpFromSceneData(startData.getProperty(i->shortName, var()), endData.getProperty(i->shortName, var()), weight);
 }
 
@@ -41,6 +41,7 @@ public:
     Array<ChainVizTarget *> getChainVizTargetsForObjectAndComponent(Object* o, ComponentType t);
 
     void resetEffectsTimes();
+    void fillTimeDependentEffects(Array<Effect*>& result);
 
     var getSceneData();
     void updateSceneData(var& sceneData);
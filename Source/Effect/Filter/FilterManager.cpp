@@ -10,6 +10,8 @@
 
 #include "Effect/EffectIncludes.h"
 
+Atomic<int> FilterManager::contextVersion;
+
 FilterManager::FilterManager() :
     BaseManager("Filters")
 {
@@ -22,10 +24,13 @@ FilterManager::FilterManager() :
 
     weightOperator = addEnumParameter("Operator", "Decides how filters are working together.");
     weightOperator->addOption("Max", MAX)->addOption("Min", MIN)->addOption("Multiply", MULTIPLY);
+
+    addBaseManagerListener(this);
 }
 
 FilterManager::~FilterManager()
 {
+    removeBaseManagerListener(this);
 }
 
 var FilterManager::getSceneData()
@@ -78,6 +83,25 @@ bool FilterManager::isAffectingObject(Object* o)
 }
 
 FilterResult FilterManager::getFilteredResultForComponent(Object* o, ObjectComponent* c)
+{
+    //read before computing, so a change happening during the computation leaves a stale entry
+    int64 version = getCacheVersion();
+
+    int context = (int)(version >> 32);
+    int lastContext = cacheContextVersion.get();
+    if (lastContext != context && cacheContextVersion.compareAndSetBool(context, lastContext)) resultCache.clear();
+
+    const void* key = c != nullptr ? (const void*)c : (const void*)o;
+
+    CachedResult cached = resultCache[key];
+    if (cached.version == version) return cached.result;
+
+    FilterResult result = computeFilteredResultForComponent(o, c);
+    resultCache.set(key, { version, result });
+    return result;
+}
+
+FilterResult FilterManager::computeFilteredResultForComponent(Object* o, ObjectComponent* c)
 {
     //if (c != nullptr && !componentSelector.selectedComponents[c->componentType]) return FilterResult();
 
@@ -114,6 +138,39 @@ FilterResult FilterManager::getFilteredResultForComponent(Object* o, ObjectCompo
     return result;
 }
 
+void FilterManager::invalidateCache()
+{
+    ++filterVersion;
+    resultCache.clear();
+}
+
+void FilterManager::addItemInternal(Filter* f, var data)
+{
+    invalidateCache();
+}
+
+void FilterManager::removeItemInternal(Filter* f)
+{
+    invalidateCache();
+}
+
+void FilterManager::itemsReordered()
+{
+    invalidateCache();
+}
+
+void FilterManager::onContainerParameterChanged(Parameter* p)
+{
+    BaseManager::onContainerParameterChanged(p);
+    if (p == weightOperator) invalidateCache();
+}
+
+void FilterManager::onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c)
+{
+    BaseManager::onControllableFeedbackUpdate(cc, c);
+    invalidateCache(); //any parameter of any filter, including their ids, groups and fade curves
+}
+
 InspectableEditor* FilterManager::getEditorInternal(bool isRoot, Array<Inspectable*> inspectables)
 {
     return new FilterManagerEditor(this, isRoot);
@@ -11,7 +11,8 @@
 #pragma once
 
 class FilterManager :
-	public BaseManager<Filter>
+	public BaseManager<Filter>,
+	public BaseManager<Filter>::ManagerListener
 {
 public:
 	FilterManager();
@@ -28,6 +29,30 @@ public:
 
 	bool isAffectingObject(Object* o);
 	FilterResult getFilteredResultForComponent(Object* o, ObjectComponent* c);
+	FilterResult computeFilteredResultForComponent(Object* o, ObjectComponent* c);
+
+	//Results are cached per object / component and stamped with the version they were computed with.
+	//The local version changes with the filters, the context version with anything filters depend on (groups, layouts, object IDs and positions)
+	struct CachedResult
+	{
+		int64 version = -1;
+		FilterResult result;
+	};
+
+	HashMap<const void*, CachedResult, DefaultHashFunctions, SpinLock> resultCache;
+	Atomic<int> filterVersion;
+	static Atomic<int> contextVersion;
+	Atomic<int> cacheContextVersion; //entries are keyed by pointer, so the cache is emptied when the context changes instead of keeping dead keys
+
+	static void invalidateAllCaches() { ++contextVersion; }
+	void invalidateCache();
+	int64 getCacheVersion() const { return ((int64)contextVersion.get() << 32) | (uint32)filterVersion.get(); }
+
+	void addItemInternal(Filter* f, var data) override;
+	void removeItemInternal(Filter* f) override;
+	void itemsReordered() override; //the id of a result comes from the last matching filter
+	void onContainerParameterChanged(Parameter* p) override;
+	void onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c) override;
 
 	InspectableEditor* getEditorInternal(bool isRoot, Array<Inspectable*> inspectables = {}) override;
 
@@ -13,7 +13,10 @@ ChangeBroadcaster LayoutFilter::broadcaster;
 
 LayoutFilter::LayoutFilter() :
     Filter(getTypeString()),
-    fadeCurve("Fade Curve")
+    fadeCurve("Fade Curve"),
+    rangeVersion(-1),
+    rangeLayout(nullptr),
+    rangeIsExclusive(false)
 {
     layout = addTargetParameter("Layout", "The layout to use. Leave blank or disable to use current layout", StageLayoutManager::getInstance(), false);
     layout->maxDefaultSearchLevel = 0;
@@ -49,6 +52,12 @@ void LayoutFilter::clearItem()
     broadcaster.sendChangeMessage();
 }
 
+void LayoutFilter::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+    Filter::onControllableFeedbackUpdateInternal(cc, c);
+    ++filterVersion;
+}
+
 bool LayoutFilter::isAffectingObject(Object* o)
 {
     return true;
@@ -59,8 +68,30 @@ FilterResult LayoutFilter::getFilteredResultForComponentInternal(Object* o, Obje
     if (size->floatValue() == 0) return FilterResult();
    
     LayoutMode m = mode->getValueDataAsEnum<LayoutMode>();
+    StageLayout* sl = (layout->enabled && layout->targetContainer != nullptr) ? (StageLayout*)layout->targetContainer.get() : nullptr;
+
+    if (m == RADIUS && sl != nullptr)
+    {
+        updateRangeIfNeeded(sl);
 
-    Vector3D<float> pos = (layout->enabled && layout->targetContainer != nullptr) ? ((StageLayout *)layout->targetContainer.get())->getObjectPosition(o) : o->stagePosition->getVector();
+        float distance = -1;
+        bool isExclusive = false;
+        {
+            GenericScopedLock lock(rangeLock);
+            isExclusive = rangeIsExclusive;
+            if (isExclusive && objectsInRange.contains(o)) distance = objectsInRange[o];
+        }
+
+        if (isExclusive)
+        {
+            if (distance < 0) return FilterResult();
+            float weight = getWeightForDistance(distance);
+            if (weight <= 0) return FilterResult();
+            return FilterResult({ o->globalID->intValue(), weight });
+        }
+    }
+
+    Vector3D<float> pos = sl != nullptr ? sl->getObjectPosition(o) : o->stagePosition->getVector();
     Vector3D<float> diffPos = pos - position->getVector();
     float diff = 0;
 
@@ -72,9 +103,36 @@ FilterResult LayoutFilter::getFilteredResultForComponentInternal(Object* o, Obje
     case AXIS_Z: diff = diffPos.z + size->floatValue() / 2; break;
     }
 
-    float p = diff / size->floatValue();
-    float weight = fadeCurve.getValueAtPosition(p);
+    float weight = getWeightForDistance(diff);
 
     if (weight <= 0) return FilterResult();
     return FilterResult({ o->globalID->intValue(), weight });
 }
+
+float LayoutFilter::getWeightForDistance(float diff)
+{
+    return fadeCurve.getValueAtPosition(diff / size->floatValue());
+}
+
+void LayoutFilter::updateRangeIfNeeded(StageLayout* sl)
+{
+    int64 version = ((int64)FilterManager::contextVersion.get() << 32) | (uint32)filterVersion.get();
+    if (rangeVersion.get() == version && rangeLayout == sl) return;
+
+    GenericScopedLock lock(rangeLock);
+    if (rangeVersion.get() == version && rangeLayout == sl) return;
+
+    //positions past the end of the curve keep its last value
+    rangeIsExclusive = fadeCurve.getValueAtPosition(1) <= 0;
+    objectsInRange.clear();
+
+    if (rangeIsExclusive)
+    {
+        Vector3D<float> center = position->getVector();
+        sl->getObjectsInRadius(center, size->floatValue(), queryResult);
+        for (auto& io : queryResult) objectsInRange.set(io.object, (io.position - center).length());
+    }
+
+    rangeLayout = sl;
+    rangeVersion = version;
+}
@@ -27,7 +27,21 @@ public:
     FloatParameter* size;
     Automation fadeCurve;
 
+    //Radius mode on a layout : objects in range are queried from the layout index once per change,
+    //if the curve fades to 0 at the radius, the other objects are known to have no weight without checking them
+    Atomic<int> filterVersion;
+    CriticalSection rangeLock;
+    Atomic<int64> rangeVersion;
+    StageLayout* rangeLayout;
+    bool rangeIsExclusive;
+    HashMap<Object*, float> objectsInRange; //distance to the center
+    Array<StageLayout::IndexedObject> queryResult;
+
+    void updateRangeIfNeeded(StageLayout* sl);
+    float getWeightForDistance(float diff);
+
     void clearItem() override;
+    void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
     bool isAffectingObject(Object * o) override;
     virtual FilterResult getFilteredResultForComponentInternal(Object* o, ObjectComponent* c) override;
@@ -62,8 +62,55 @@ void ColorEffect::processComponentInternal(Object* o, ObjectComponent* c, const
 	{
 		if (vizParameter != nullptr && !vizParameter.wasObjectDeleted() && vizComputedParamRef != nullptr && vizComputedParamRef == c->mainParameter)
 		{
-			((ColorParameter*)vizParameter.get())->setColor(targetColors[0]);
+			o->setVizValue(vizParameter.get(), result[0].clone());
 		}
 	}
 
-}
\ No newline at end of file
+}
+
+void ColorEffect::processComponentSlotsInternal(Object* o, ObjectComponent* c, const float* slots, float* targetSlots, int id, float time)
+{
+	const ObjectComponent::ComputedSlot* s = c->getComputedSlot(nullptr); //pixels are laid out as rgba floats
+	if (s == nullptr) return;
+
+	int resolution = ((ColorComponent*)c)->resolution->intValue();
+	int numPixels = jmin(resolution, s->numItems);
+
+	thread_local Array<Colour, CriticalSection> targetColors; //reused, sizes rarely change between components
+	targetColors.resize(resolution);
+
+	const float* pixels = slots + s->offset;
+	for (int i = 0; i < resolution; i++)
+	{
+		if (!fillWithOriginalColors) targetColors.set(i, Colour());
+		else if (i >= numPixels) targetColors.set(i, Colours::black);
+		else targetColors.set(i, Colour::fromFloatRGBA(pixels[i * 4], pixels[i * 4 + 1], pixels[i * 4 + 2], pixels[i * 4 + 3]));
+	}
+
+	processedEffectColorsInternal(targetColors, o, (ColorComponent*)c, id, time);
+
+	float* target = targetSlots + s->offset;
+	for (int i = 0; i < numPixels && i < targetColors.size(); i++)
+	{
+		const Colour& col = targetColors.getReference(i);
+		target[i * 4] = col.getFloatRed();
+		target[i * 4 + 1] = col.getFloatGreen();
+		target[i * 4 + 2] = col.getFloatBlue();
+		target[i * 4 + 3] = col.getFloatAlpha();
+	}
+
+	//viz
+	if (targetColors.size() > 0)
+	{
+		if (vizParameter != nullptr && !vizParameter.wasObjectDeleted() && vizComputedParamRef != nullptr && vizComputedParamRef == c->mainParameter)
+		{
+			Colour col = targetColors[0];
+			var v;
+			v.append(col.getFloatRed());
+			v.append(col.getFloatGreen());
+			v.append(col.getFloatBlue());
+			v.append(col.getFloatAlpha());
+			o->setVizValue(vizParameter.get(), v);
+		}
+	}
+}
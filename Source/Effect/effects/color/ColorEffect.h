@@ -23,6 +23,9 @@ public:
 
 	void processComponentInternal(Object* o, ObjectComponent* c, const HashMap<Parameter*, var>& values, HashMap<Parameter*, var>& targetValues, int id, float time = -1) override;
 
+	bool canProcessSlots(ObjectComponent* c) override { return c->componentType == COLOR; }
+	void processComponentSlotsInternal(Object* o, ObjectComponent* c, const float* slots, float* targetSlots, int id, float time = -1) override;
+
 	virtual void processedEffectColorsInternal(Array<Colour, CriticalSection>& colors, Object* o, ColorComponent* c,int id, float time = -1) {}
 
 };
\ No newline at end of file
@@ -55,6 +55,11 @@ void ColorSourceOverrideEffect::colorSourceParamControlModeChanged(Parameter* p)
 	effectListeners.call(&EffectListener::effectParamControlModeChanged, p);
 }
 
+bool ColorSourceOverrideEffect::isTimeDependent()
+{
+	return colorSource != nullptr && colorSource->isTimeDependent();
+}
+
 var ColorSourceOverrideEffect::getJSONData()
 {
 	var data = ColorEffect::getJSONData();
@@ -29,6 +29,8 @@ public:
 
     virtual void colorSourceParamControlModeChanged(Parameter* p) override;
 
+    bool isTimeDependent() override;
+
     var getJSONData() override;
     void loadJSONDataItemInternal(var data) override;
 
@@ -92,12 +92,14 @@ void OrientationTargetEffect::processComponentTimeInternal(Object* o, ObjectComp
 	case LINE:
 	{
 		jassert(params.size() >= 2);
-		var start = GetLinkedValue(params[0]);
-		var end = GetLinkedValue(params[1]);
+		float start[3] = { 0, 0, 0 };
+		float end[3] = { 0, 0, 0 };
+		int numValues = GetLinkedValues(params[0], start);
+		GetLinkedValues(params[1], end);
 		float relPos = id * 1.0f / jmax(numObjects - 1, 1);
 
 		var v;
-		for (int i = 0; i < start.size(); i++)
+		for (int i = 0; i < numValues; i++)
 		{
 			v.append(jmap<float>(relPos, start[i], end[i]));
 
@@ -109,8 +111,10 @@ void OrientationTargetEffect::processComponentTimeInternal(Object* o, ObjectComp
 	case CIRCLE:
 	{
 		jassert(params.size() >= 6);
-		var centerV = GetLinkedValue(params[0]);
-		var orientationV = GetLinkedValue(params[1]);
+		float centerV[3] = { 0, 0, 0 };
+		float orientationV[3] = { 0, 0, 0 };
+		GetLinkedValues(params[0], centerV);
+		GetLinkedValues(params[1], orientationV);
 		float radius = GetLinkedValue(params[2]);
 		float offset = GetLinkedValue(params[3]);
 		float start = GetLinkedValue(params[4]);
@@ -130,7 +134,7 @@ void OrientationTargetEffect::processComponentTimeInternal(Object* o, ObjectComp
 		float px = cos(angle) * radius;
 		float pz = sin(angle) * radius;
 
-		Vector3D<float> radRot = Vector3D<float>(degreesToRadians((float)orientationV[0]), degreesToRadians((float)orientationV[1]), degreesToRadians((float)orientationV[2]));
+		Vector3D<float> radRot = Vector3D<float>(degreesToRadians(orientationV[0]), degreesToRadians(orientationV[1]), degreesToRadians(orientationV[2]));
 		Quat q = Quat::FromEuler(radRot);
 		Vec3 p = q * Vec3(px, 0, pz) + center;
 
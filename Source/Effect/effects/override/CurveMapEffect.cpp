@@ -41,7 +41,7 @@ void CurveMapEffect::processComponentInternal(Object* o, ObjectComponent* c, con
 
 		if (val.isArray())
 		{
-			for (int j = 0; j < values.size(); j++)
+			for (int j = 0; j < val.size(); j++)
 			{
 				float normVal = 0;
 				if (inR[0] != inR[1]) normVal = jmap<float>(val[j], inR[0], inR[1], 0, 1);
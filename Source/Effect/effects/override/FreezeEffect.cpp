@@ -74,9 +74,9 @@ void FreezeFloatEffect::processComponentFreezeInternal(Object* o, ObjectComponen
 
 		if (val.isArray())
 		{
-			for (int i = 0; i < values.size(); i++)
+			for (int i = 0; i < val.size() && i < prevVal.size(); i++)
 			{
-				targetVal = m == MAX ? jmax((float)prevVal, (float)val[i]) : jmin((float)prevVal[i], (float)val[i]);
+				targetVal[i] = m == MAX ? jmax((float)prevVal[i], (float)val[i]) : jmin((float)prevVal[i], (float)val[i]);
 			}
 		}
 		else
@@ -38,4 +38,15 @@ void OverrideFloatEffect::processComponentInternal(Object* o, ObjectComponent* c
 
     float val = GetLinkedValue(value);
     targetValues.set(c->mainParameter, val);
-}
\ No newline at end of file
+}
+
+bool OverrideFloatEffect::canProcessSlots(ObjectComponent* c)
+{
+    const ObjectComponent::ComputedSlot* s = c->getComputedSlot(c->mainParameter);
+    return s != nullptr && s->numItems == 0;
+}
+
+void OverrideFloatEffect::processComponentSlotsInternal(Object* o, ObjectComponent* c, const float* slots, float* targetSlots, int id, float time)
+{
+    targetSlots[c->getComputedSlot(c->mainParameter)->offset] = GetLinkedValue(value);
+}
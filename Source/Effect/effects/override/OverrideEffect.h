@@ -29,6 +29,9 @@ public:
     
     void processComponentInternal(Object* o, ObjectComponent* c, const HashMap<Parameter*, var>& values, HashMap<Parameter*, var>& targetValues, int id, float time = -1) override;
 
+    bool canProcessSlots(ObjectComponent* c) override;
+    void processComponentSlotsInternal(Object* o, ObjectComponent* c, const float* slots, float* targetSlots, int id, float time = -1) override;
+
     String getTypeString() const override { return getTypeStringStatic(); }
     const static String getTypeStringStatic() { return "Override (Number)"; }
     static OverrideFloatEffect* create(var params) { return new OverrideFloatEffect(params); }
@@ -17,7 +17,7 @@ public:
     SmoothingEffect(var params = var());
     virtual ~SmoothingEffect();
 
-    HashMap<ObjectComponent*, double> prevTimes;
+    HashMap<ObjectComponent*, double, DefaultHashFunctions, CriticalSection> prevTimes;
 
     FloatParameter* smoothing;
     FloatParameter* fallSmoothing;
@@ -26,6 +26,7 @@ public:
 
     virtual void onContainerTriggerTriggered(Trigger* t) override;
     virtual void onContainerParameterChangedInternal(Parameter* p) override;
+    bool isTimeDependent() override { return true; }
 
     void processComponentInternal(Object* o, ObjectComponent* c, const HashMap<Parameter*, var>& values, HashMap<Parameter*, var>& targetValues, int id, float time = -1) override;
 
@@ -46,6 +46,12 @@ void TimedEffect::onContainerTriggerTriggered(Trigger* t)
 	if (t == resetTimeTrigger) resetTimes();
 }
 
+void TimedEffect::effectParamChanged(Controllable* c)
+{
+	Effect::effectParamChanged(c);
+	if (c == speed) ++speedVersion;
+}
+
 void TimedEffect::updateEnabled()
 {
 	if (isFullyEnabled())
@@ -72,7 +78,10 @@ void TimedEffect::processComponentInternal(Object* o, ObjectComponent* c, const
 		Parameter* p = c->mainParameter;
 		if (prevValuesMap[c]->contains(p) && values.contains(p))
 		{
-			if ((float)(*prevValuesMap[c])[p] == 0 && (float)values[p] > 0) curTimes.set(c, 0);
+			if ((float)(*prevValuesMap[c])[p] == 0 && (float)values[p] > 0)
+			{
+				if (TimeState* ts = getTimeState(c)) ts->time = 0;
+			}
 		}
 	}
 
@@ -87,32 +96,58 @@ void TimedEffect::processComponentInternal(Object* o, ObjectComponent* c, const
 
 float TimedEffect::getCurrentTime(Object* o, ObjectComponent* c, int id, float timeOverride)
 {
-	if (!curTimes.contains(c)) curTimes.set(c, 0);
-	if (timeOverride == -1) return curTimes[c];
+	if (timeOverride == -1)
+	{
+		TimeState* ts = getTimeState(c);
+		return ts != nullptr ? ts->time : 0;
+	}
 
 	float time = timeOverride * (float)GetLinkedValueT(speed, timeOverride); //speed should be calculated from start of the animation, if animated (area under curve for automation)
 
 	return time;
 }
 
+TimedEffect::TimeState* TimedEffect::getTimeState(ObjectComponent* c)
+{
+	//the array is only resized in updateStart, before objects are computed. Components created since then get their time from the next frame
+	if (c == nullptr || c->stateIndex >= curTimes.size()) return nullptr;
+
+	TimeState& ts = curTimes.getReference(c->stateIndex);
+	if (ts.component != c) ts = { c, true, 0, 1, -1 }; //new component or recycled index
+	ts.active = true;
+	return &ts;
+}
 
 void TimedEffect::resetTimes()
 {
-	HashMap<ObjectComponent*, float>::Iterator it(curTimes);
-	while (it.next()) curTimes.set(it.getKey(), 0);
+	GenericScopedLock lock(timesLock);
+	for (auto& ts : curTimes) ts.time = 0;
 }
 
 void TimedEffect::resetTime(Object* o)
 {
-	for (auto& c : o->componentManager->items) if (curTimes.contains(c)) curTimes.set(c, 0);
+	GenericScopedLock lock(timesLock);
+	for (auto& c : o->componentManager->items)
+	{
+		if (c->stateIndex < curTimes.size() && curTimes[c->stateIndex].component == c) curTimes.getReference(c->stateIndex).time = 0;
+	}
 }
 
-void TimedEffect::itemRemoved(Object* o)
+void TimedEffect::deactivateTimes(Object* o)
 {
+	GenericScopedLock lock(timesLock);
 	for (auto& c : o->componentManager->items)
 	{
-		curTimes.remove(c);
+		if (c->stateIndex < curTimes.size() && curTimes[c->stateIndex].component == c) curTimes.getReference(c->stateIndex) = TimeState();
+	}
+}
+
+void TimedEffect::itemRemoved(Object* o)
+{
+	deactivateTimes(o);
 
+	for (auto& c : o->componentManager->items)
+	{
 		if (prevValuesMap.contains(c))
 		{
 			prevValues.removeObject(prevValuesMap[c]);
@@ -123,19 +158,7 @@ void TimedEffect::itemRemoved(Object* o)
 
 void TimedEffect::itemsRemoved(Array<Object*> oList)
 {
-	for (auto& o : oList)
-	{
-		for (auto& c : o->componentManager->items)
-		{
-			curTimes.remove(c);
-
-			if (prevValuesMap.contains(c))
-			{
-				prevValues.removeObject(prevValuesMap[c]);
-				prevValuesMap.remove(c);
-			}
-		}
-	}
+	for (auto& o : oList) itemRemoved(o);
 }
 
 void TimedEffect::updateStart()
@@ -152,15 +175,35 @@ void TimedEffect::updateStart()
 void TimedEffect::addTime()
 {
 	double newTime = Time::getMillisecondCounterHiRes() / 1000.0;
+	float deltaTime = newTime - timeAtLastUpdate;
+	timeAtLastUpdate = newTime;
+
+	GenericScopedLock lock(timesLock);
+
+	int numIndices = ObjectComponent::numStateIndices;
+	if (curTimes.size() < numIndices) curTimes.resize(numIndices);
 
-	HashMap<ObjectComponent*, float>::Iterator it(curTimes);
-	while (it.next())
+	ParameterLink* speedLink = effectParams.paramsCanBeLinked ? effectParams.getLinkedParam(speed) : nullptr;
+	if (speedLink == nullptr || speedLink->linkType == ParameterLink::NONE)
 	{
-		Object* o = it.getKey()->object;
-		int id = o->globalID->intValue();
-		curTimes.set(it.getKey(), it.getValue() + (newTime - timeAtLastUpdate) * (float)GetLinkedValueT(speed, 0));
+		//same speed for everyone, resolved once
+		float speedDelta = deltaTime * (float)effectParams.getParamValue(speed, 0);
+		for (auto& ts : curTimes) if (ts.active) ts.time += speedDelta;
+		return;
 	}
 
-	timeAtLastUpdate = newTime;
+	int version = ParameterLink::sourceVersion.get() + speedVersion.get(); //both only go up
+	for (auto& ts : curTimes)
+	{
+		if (!ts.active) continue;
+		if (ts.speedVersion != version)
+		{
+			Object* o = ts.component->object;
+			int id = o->globalID->intValue();
+			ts.speed = (float)GetLinkedValueT(speed, 0);
+			ts.speedVersion = version;
+		}
 
-}
\ No newline at end of file
+		ts.time += deltaTime * ts.speed;
+	}
+}
@@ -33,12 +33,29 @@ public:
 	bool forceManualTime;
 
 	double timeAtLastUpdate;
-	HashMap<ObjectComponent*, float> curTimes;
 
+	//Per component times, indexed by ObjectComponent::stateIndex. Linked speeds are cached per component
+	//and only resolved again when the link sources or the speed change
+	struct TimeState
+	{
+		ObjectComponent* component = nullptr;
+		bool active = false;
+		float time = 0;
+		float speed = 1;
+		int speedVersion = -1;
+	};
 
+	Array<TimeState> curTimes;
+	CriticalSection timesLock;
+	Atomic<int> speedVersion;
+
+	TimeState* getTimeState(ObjectComponent* c);
+	void deactivateTimes(Object* o);
 
 	virtual void onContainerTriggerTriggered(Trigger* t) override;
+	virtual void effectParamChanged(Controllable* c) override;
 	virtual void updateEnabled() override;
+	virtual bool isTimeDependent() override { return !forceManualTime; }
 
 	void processComponentInternal(Object* o, ObjectComponent* c, const HashMap<Parameter*, var>& values, HashMap<Parameter*, var>& targetValues, int id, float time = -1) override;
 	virtual void processComponentTimeInternal(Object* o, ObjectComponent* c, const HashMap<Parameter*, var>& values, HashMap<Parameter*, var>& targetValues, int id, float time = -1, float originalTime = -1) {}
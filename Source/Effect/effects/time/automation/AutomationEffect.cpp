@@ -90,12 +90,13 @@ void AutomationEffect::effectParamChanged(Controllable* c)
 		if (!loop->boolValue())
 		{
 			//force put curTime in 0-length range to have good ending behaviour
-			HashMap<ObjectComponent*, float>::Iterator it(curTimes);
-			while (it.next())
+			GenericScopedLock lock(timesLock);
+			for (auto& ts : curTimes)
 			{
-				Object* o = it.getKey()->object;
+				if (!ts.active) continue;
+				Object* o = ts.component->object;
 				int id = o->globalID->intValue();
-				curTimes.set(it.getKey(), fmodf(it.getValue(), GetLinkedValueT(length, 0)));
+				ts.time = fmodf(ts.time, GetLinkedValueT(length, 0));
 			}
 		}
 	}
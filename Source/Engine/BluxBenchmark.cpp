@@ -0,0 +1,330 @@
+/*
+  ==============================================================================
+
+    BluxBenchmark.cpp
+    Created: 18 Oct 2026 2:40:18pm
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "MainIncludes.h"
+#include <iostream>
+
+#if BLUX_BENCHMARK_ALLOC_COUNT
+static std::atomic<int64> benchmarkNumAllocations { 0 };
+
+void* operator new(std::size_t size)
+{
+    benchmarkNumAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    benchmarkNumAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+
+BluxBenchmark::BluxBenchmark(const String& commandLine) :
+    Thread("Benchmark")
+{
+    ArgumentList args("Blux", commandLine);
+
+    auto getInt = [&args](StringRef option, int defaultValue)
+    {
+        return args.containsOption(option) ? args.getValueForOption(option).getIntValue() : defaultValue;
+    };
+
+    if (args.containsOption("--file")) showFile = File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--file"));
+    if (args.containsOption("--report")) reportFile = File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--report"));
+
+    numObjects = jmax(1, getInt("--objects", 200));
+    numPixels = jmax(1, getInt("--pixels", 16));
+    numEffects = jmax(0, getInt("--effects", 20));
+    numGroups = jmax(0, getInt("--groups", 10));
+    numScenes = jmax(0, getInt("--scenes", 4));
+    numSequences = jmax(0, getInt("--sequences", 2));
+    numFrames = jmax(1, getInt("--frames", 2000));
+    numWarmupFrames = jmax(0, getInt("--warmup", 100));
+    sceneInterval = jmax(1, getInt("--sceneinterval", 250));
+    numThreads = jmax(1, getInt("--threads", 1));
+    onlyComputeChanges = getInt("--onlychanges", 0) != 0;
+}
+
+BluxBenchmark::~BluxBenchmark()
+{
+    stopThread(5000);
+}
+
+bool BluxBenchmark::isRequested()
+{
+    return JUCEApplicationBase::getCommandLineParameterArray().contains("--benchmark");
+}
+
+int64 BluxBenchmark::getNumAllocations()
+{
+#if BLUX_BENCHMARK_ALLOC_COUNT
+    return benchmarkNumAllocations.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+void BluxBenchmark::launch()
+{
+    if (showFile != File())
+    {
+        if (!showFile.existsAsFile())
+        {
+            std::cerr << "Benchmark : file not found " << showFile.getFullPathName() << std::endl;
+            JUCEApplication::getInstance()->setApplicationReturnValue(1);
+            JUCEApplication::quit();
+            return;
+        }
+
+        Engine::mainEngine->loadDocument(showFile);
+    }
+    else
+    {
+        generateShow();
+    }
+
+    startThread();
+}
+
+void BluxBenchmark::generateShow()
+{
+    Random r(1234); //fixed seed so generated shows are the same between runs
+
+    //the DMX interface is left on Open DMX without a port, so values go through the whole DMX path without reaching a device
+    Interface* dmx = InterfaceManager::getInstance()->factory.create("DMX");
+    InterfaceManager::getInstance()->addItem(dmx);
+
+    Array<Object*> objects;
+    for (int i = 0; i < numObjects; i++)
+    {
+        var params(new DynamicObject());
+        params.getDynamicObject()->setProperty("name", "Fixture " + String(i + 1));
+        params.getDynamicObject()->setProperty("type", "Benchmark Fixture");
+
+        var colorDef(new DynamicObject());
+        colorDef.getDynamicObject()->setProperty("resolution", numPixels);
+        colorDef.getDynamicObject()->setProperty("defaultSource", i % 2 == 0 ? "Rainbow" : "Noise");
+
+        var components(new DynamicObject());
+        components.getDynamicObject()->setProperty("Dimmer", var(new DynamicObject()));
+        components.getDynamicObject()->setProperty("Color", colorDef);
+        params.getDynamicObject()->setProperty("components", components);
+
+        Object* o = new Object(params);
+        o->stagePosition->setVector(r.nextFloat() * 10 - 5, 0, r.nextFloat() * 10 - 5);
+        objects.add(o);
+    }
+
+    ObjectManager::getInstance()->addItems(objects);
+
+    //each object uses 1 dimmer channel and 3 channels per pixel
+    int channelsPerObject = 1 + numPixels * 3;
+    int objectsPerUniverse = jmax(1, DMX_NUM_CHANNELS / channelsPerObject);
+    for (int i = 0; i < objects.size(); i++)
+    {
+        Object* o = objects[i];
+        o->targetInterface->setValueFromTarget(dmx);
+        if (DMXInterface::DMXParams* dp = dynamic_cast<DMXInterface::DMXParams*>(o->interfaceParameters.get()))
+        {
+            dp->universe->setValue(i / objectsPerUniverse);
+            dp->startChannel->setValue(1 + (i % objectsPerUniverse) * channelsPerObject);
+        }
+    }
+
+    EffectFactory* ef = EffectFactory::getInstance();
+
+    Array<Group*> groups;
+    for (int i = 0; i < numGroups; i++)
+    {
+        ObjectGroup* g = new ObjectGroup();
+        g->setNiceName("Group " + String(i + 1));
+        GroupManager::getInstance()->addItem(g);
+
+        Array<Object*> members;
+        for (auto& o : objects) if (r.nextInt(numGroups) == 0) members.add(o);
+        g->addObjects(members);
+        groups.add(g);
+    }
+
+    //effects are spread between groups and global effects, cycling through all the effect types
+    EffectGroup* globalEffects = nullptr;
+    for (int i = 0; i < numEffects; i++)
+    {
+        Effect* e = ef->defs[i % ef->defs.size()]->create();
+        if (groups.size() > 0 && i % 2 == 0)
+        {
+            groups[i / 2 % groups.size()]->effectManager->addItem(e);
+        }
+        else
+        {
+            if (globalEffects == nullptr) globalEffects = GlobalEffectManager::getInstance()->addItem();
+            globalEffects->effectManager.addItem(e);
+        }
+    }
+
+    for (int i = 0; i < numSequences; i++)
+    {
+        BluxSequence* s = new BluxSequence();
+        s->setNiceName("Sequence " + String(i + 1));
+        GlobalSequenceManager::getInstance()->addItem(s);
+        s->totalTime->setValue(20);
+        s->loopParam->setValue(true);
+
+        EffectLayer* l = new EffectLayer(s, var());
+        s->layerManager->addItem(l);
+
+        for (int j = 0; j < 4; j++)
+        {
+            var bParams(new DynamicObject());
+            bParams.getDynamicObject()->setProperty("effectType", ef->defs[(i * 4 + j) % ef->defs.size()]->type);
+            EffectBlock* b = new EffectBlock(bParams);
+            b->time->setValue(j * 5);
+            b->coreLength->setValue(5);
+            l->blockManager.addItem(b);
+        }
+
+        s->playTrigger->trigger();
+    }
+
+    for (int i = 0; i < numScenes; i++)
+    {
+        for (auto& o : objects)
+        {
+            if (DimmerComponent* d = o->getComponent<DimmerComponent>()) d->value->setValue(r.nextFloat());
+        }
+
+        Scene* s = new Scene("Scene " + String(i + 1));
+        SceneManager::getInstance()->addItem(s);
+        s->saveScene();
+    }
+}
+
+void BluxBenchmark::run()
+{
+    while (Engine::mainEngine->isLoadingFile && !threadShouldExit()) sleep(10);
+    if (threadShouldExit()) return;
+
+    ObjectManager* om = ObjectManager::getInstance();
+    om->stopThread(2000);
+
+    om->multiThreadedUpdate->setValue(numThreads > 1);
+    om->updateThreads->setValue(numThreads);
+    om->onlyComputeChanges->setValue(onlyComputeChanges);
+    om->profiler.enabled->setValue(true);
+    om->profiler.reset();
+
+    SceneManager* sm = SceneManager::getInstance();
+
+    for (int i = 0; i < numWarmupFrames && !threadShouldExit(); i++) om->processFrame();
+
+    frameTimes.ensureStorageAllocated(numFrames);
+    frameAllocations.ensureStorageAllocated(numFrames);
+
+    for (int i = 0; i < numFrames && !threadShouldExit(); i++)
+    {
+        if (sm->items.size() > 0 && i % sceneInterval == 0)
+        {
+            Scene* s = sm->items[(i / sceneInterval) % sm->items.size()];
+            MessageManager::callAsync([sm, s]() { sm->loadScene(s, .5f, false); });
+        }
+
+        int64 allocationsBefore = getNumAllocations();
+        int64 ticksBefore = Time::getHighResolutionTicks();
+
+        om->processFrame();
+
+        frameTimes.add((float)(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - ticksBefore) * 1000));
+        frameAllocations.add(getNumAllocations() - allocationsBefore);
+    }
+
+    om->stopUpdateWorkers();
+    for (auto& s : om->profiler.stages) s->updateStats();
+
+    var report = getReport();
+    String reportText = JSON::toString(report);
+    std::cout << reportText << std::endl;
+    if (reportFile != File()) reportFile.replaceWithText(reportText);
+
+    MessageManager::callAsync([]() { JUCEApplication::quit(); });
+}
+
+var BluxBenchmark::getReport()
+{
+    var data(new DynamicObject());
+
+    var show(new DynamicObject());
+    show.getDynamicObject()->setProperty("file", showFile.getFullPathName());
+    show.getDynamicObject()->setProperty("objects", ObjectManager::getInstance()->items.size());
+    show.getDynamicObject()->setProperty("groups", GroupManager::getInstance()->items.size());
+    show.getDynamicObject()->setProperty("scenes", SceneManager::getInstance()->items.size());
+    show.getDynamicObject()->setProperty("sequences", GlobalSequenceManager::getInstance()->items.size());
+    show.getDynamicObject()->setProperty("threads", numThreads);
+    show.getDynamicObject()->setProperty("onlyComputeChanges", onlyComputeChanges);
+    data.getDynamicObject()->setProperty("show", show);
+
+    int n = frameTimes.size();
+    data.getDynamicObject()->setProperty("frames", n);
+    if (n == 0) return data;
+
+    Array<float> sortedTimes(frameTimes);
+    sortedTimes.sort();
+
+    double totalTime = 0;
+    for (auto& t : frameTimes) totalTime += t;
+
+    auto percentile = [&sortedTimes, n](float p) { return sortedTimes[jmin(n - 1, (int)(n * p))]; };
+
+    var latency(new DynamicObject());
+    latency.getDynamicObject()->setProperty("min", sortedTimes[0]);
+    latency.getDynamicObject()->setProperty("avg", totalTime / n);
+    latency.getDynamicObject()->setProperty("p50", percentile(.5f));
+    latency.getDynamicObject()->setProperty("p90", percentile(.9f));
+    latency.getDynamicObject()->setProperty("p99", percentile(.99f));
+    latency.getDynamicObject()->setProperty("max", sortedTimes[n - 1]);
+    data.getDynamicObject()->setProperty("frameTimeMs", latency);
+    data.getDynamicObject()->setProperty("framesPerSecond", totalTime > 0 ? n * 1000.0 / totalTime : 0);
+
+#if BLUX_BENCHMARK_ALLOC_COUNT
+    int64 totalAllocations = 0;
+    int64 maxAllocations = 0;
+    for (auto& a : frameAllocations)
+    {
+        totalAllocations += a;
+        maxAllocations = jmax(maxAllocations, a);
+    }
+
+    var allocations(new DynamicObject());
+    allocations.getDynamicObject()->setProperty("avg", (double)totalAllocations / n);
+    allocations.getDynamicObject()->setProperty("max", maxAllocations);
+    data.getDynamicObject()->setProperty("allocationsPerFrame", allocations);
+#endif
+
+    var stages(new DynamicObject());
+    for (auto& s : ObjectManager::getInstance()->profiler.stages)
+    {
+        var stage(new DynamicObject());
+        stage.getDynamicObject()->setProperty("min", s->minTime->floatValue());
+        stage.getDynamicObject()->setProperty("avg", s->avgTime->floatValue());
+        stage.getDynamicObject()->setProperty("p99", s->p99Time->floatValue());
+        stages.getDynamicObject()->setProperty(s->niceName, stage);
+    }
+    data.getDynamicObject()->setProperty("stagesMs", stages);
+
+    return data;
+}
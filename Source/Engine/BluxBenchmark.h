@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    BluxBenchmark.h
+    Created: 18 Oct 2026 2:40:18pm
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Counting allocations replaces the global operator new, so it is only compiled in dedicated benchmark builds
+#ifndef BLUX_BENCHMARK_ALLOC_COUNT
+#define BLUX_BENCHMARK_ALLOC_COUNT 0
+#endif
+
+/*
+Headless benchmark, started with "Blux --benchmark [options]".
+No window is created : the show is loaded from --file or generated, then ObjectManager frames are
+processed back to back from this thread and a report is printed before quitting.
+
+Options (with their default) :
+--file=<show.blux>		load this show instead of generating one
+--objects=200 --pixels=16 --effects=20 --groups=10 --scenes=4 --sequences=2
+--frames=2000 --warmup=100 --sceneinterval=250 --threads=1 --onlychanges=0
+--report=<report.json>	also write the report as JSON
+Allocations per frame are only reported when built with BLUX_BENCHMARK_ALLOC_COUNT=1.
+*/
+class BluxBenchmark :
+    public Thread
+{
+public:
+    BluxBenchmark(const String& commandLine);
+    ~BluxBenchmark();
+
+    static bool isRequested(); //checked before the application creates its window
+    static int64 getNumAllocations(); //process-wide count of operator new calls, 0 if not counted
+
+    File showFile;
+    File reportFile;
+    int numObjects;
+    int numPixels;
+    int numEffects;
+    int numGroups;
+    int numScenes;
+    int numSequences;
+    int numFrames;
+    int numWarmupFrames;
+    int sceneInterval;
+    int numThreads;
+    bool onlyComputeChanges;
+
+    Array<float> frameTimes;
+    Array<int64> frameAllocations;
+
+    void launch();
+    void generateShow();
+
+    void run() override;
+
+    var getReport();
+};
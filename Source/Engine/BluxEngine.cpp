@@ -18,7 +18,8 @@
 #include "Common/CommonIncludes.h"
 
 BluxEngine::BluxEngine() :
-	Engine("Blux", ".blux")
+	Engine("Blux", ".blux"),
+	batchVizUpdates(false)
 {
 	mainEngine = this;
 	addChildControllableContainer(ObjectManager::getInstance());
@@ -40,11 +41,13 @@ BluxEngine::BluxEngine() :
 	breakingChangesVersions.add("1.2.0");
 
 	initVizServer();
+	updateVizStreaming();
 }
 
 BluxEngine::~BluxEngine()
 {
 	isClearing = true;
+	stopTimer();
 	ObjectManager::getInstance()->clear();
 	ObjectManager::deleteInstance();
 	GroupManager::deleteInstance();
@@ -108,6 +111,14 @@ void BluxEngine::initVizServer()
 void BluxEngine::connectionOpened(const String& id)
 {
 	sendAllData(id);
+
+	if (batchVizUpdates)
+	{
+		var msgData(new DynamicObject());
+		msgData.getDynamicObject()->setProperty("type", "vizAddresses");
+		msgData.getDynamicObject()->setProperty("data", getVizAddresses());
+		sendServerMessage(JSON::toString(msgData), id);
+	}
 }
 
 void BluxEngine::messageReceived(const String& id, const String& message)
@@ -145,6 +156,152 @@ void BluxEngine::sendServerMessage(const String message, const String& id)
 	else vizServer->send(message);
 }
 
+void BluxEngine::updateVizStreaming()
+{
+	BluxSettings* s = BluxSettings::getInstance();
+	batchVizUpdates = s->batchVizUpdates->boolValue();
+
+	if (batchVizUpdates) startTimerHz(s->vizUpdateRate->intValue());
+	else
+	{
+		stopTimer();
+		GenericScopedLock lock(vizLock);
+		pendingVizParams.clearQuick();
+		pendingVizParamsMap.clear();
+	}
+}
+
+void BluxEngine::addPendingVizParam(Parameter* p)
+{
+	GenericScopedLock lock(vizLock);
+	if (pendingVizParamsMap.contains(p)) return; //only the latest value will be sent
+	pendingVizParamsMap.set(p, true);
+	pendingVizParams.add(p);
+}
+
+int BluxEngine::getVizAddressID(Parameter* p, var& newAddresses)
+{
+	if (vizAddressIDs.contains(p))
+	{
+		int id = vizAddressIDs[p];
+		if (vizAddressParams[id] == p) return id;
+	}
+
+	//new parameter, or a new one allocated where a deleted one was
+	int id = vizAddressParams.size();
+	vizAddressParams.add(p);
+	vizAddressIDs.set(p, id);
+	if (!newAddresses.isObject()) newAddresses = var(new DynamicObject());
+	newAddresses.getDynamicObject()->setProperty(String(id), p->getControlAddress(this));
+	return id;
+}
+
+var BluxEngine::getVizAddresses()
+{
+	GenericScopedLock lock(vizLock);
+	var data(new DynamicObject());
+	for (int i = 0; i < vizAddressParams.size(); i++)
+	{
+		Parameter* p = vizAddressParams[i];
+		if (p == nullptr) continue;
+		data.getDynamicObject()->setProperty(String(i), p->getControlAddress(this));
+	}
+	return data;
+}
+
+void BluxEngine::clearVizAddresses()
+{
+	GenericScopedLock lock(vizLock);
+	pendingVizParams.clearQuick();
+	pendingVizParamsMap.clear();
+	vizAddressParams.clearQuick();
+	vizAddressIDs.clear();
+}
+
+void BluxEngine::flushVizUpdates()
+{
+	Array<WeakReference<Parameter>> params;
+	{
+		GenericScopedLock lock(vizLock);
+		if (pendingVizParams.isEmpty()) return;
+		params.swapWith(pendingVizParams);
+		pendingVizParamsMap.clear();
+	}
+
+	if (vizServer == nullptr || !vizServer->isConnected) return;
+
+	var newAddresses;
+	vizBuffer.reset();
+	vizBuffer.writeByte(VIZ_VALUES);
+	vizBuffer.writeInt(0); //number of values, written at the end
+
+	int numValues = 0;
+	{
+		GenericScopedLock lock(vizLock);
+		for (auto& wp : params)
+		{
+			Parameter* p = wp.get();
+			if (p == nullptr) continue;
+
+			var v = p->getValue();
+			vizBuffer.writeInt(getVizAddressID(p, newAddresses));
+
+			if (v.isArray())
+			{
+				vizBuffer.writeByte(VIZ_ARRAY);
+				vizBuffer.writeByte((char)jmin(v.size(), 255));
+				for (int i = 0; i < jmin(v.size(), 255); i++) vizBuffer.writeFloat((float)v[i]);
+			}
+			else if (v.isBool())
+			{
+				vizBuffer.writeByte(VIZ_BOOL);
+				vizBuffer.writeByte((bool)v ? 1 : 0);
+			}
+			else if (v.isInt() || v.isInt64())
+			{
+				vizBuffer.writeByte(VIZ_INT);
+				vizBuffer.writeInt((int)v);
+			}
+			else if (v.isDouble())
+			{
+				vizBuffer.writeByte(VIZ_FLOAT);
+				vizBuffer.writeFloat((float)v);
+			}
+			else
+			{
+				String s = v.toString();
+				vizBuffer.writeByte(VIZ_STRING);
+				vizBuffer.writeInt((int)s.getNumBytesAsUTF8());
+				vizBuffer.write(s.toRawUTF8(), s.getNumBytesAsUTF8());
+			}
+
+			numValues++;
+		}
+	}
+
+	if (numValues == 0) return;
+
+	//addresses have to be known by the clients before the values using them
+	if (newAddresses.isObject())
+	{
+		var msgData(new DynamicObject());
+		msgData.getDynamicObject()->setProperty("type", "vizAddresses");
+		msgData.getDynamicObject()->setProperty("data", newAddresses);
+		sendServerMessage(JSON::toString(msgData));
+	}
+
+	vizBuffer.setPosition(1);
+	vizBuffer.writeInt(numValues);
+	vizBuffer.setPosition(vizBuffer.getDataSize());
+
+	vizServer->send((const char*)vizBuffer.getData(), (int)vizBuffer.getDataSize());
+}
+
+void BluxEngine::timerCallback()
+{
+	flushVizUpdates();
+}
+
 var BluxEngine::getVizData()
 {
 	var data(new DynamicObject());
@@ -152,14 +309,42 @@ var BluxEngine::getVizData()
 	return data;
 }
 
+//Feedback that changes every frame without changing any object value shouldn't force recomputing all objects
+static bool isValueAffectingFeedback(Controllable* c)
+{
+	if (c == nullptr) return true;
+	if (c->isControllableFeedbackOnly) return false; //progress, status and viz feedback
+
+	ControllableContainer* parent = c->parentContainer;
+	if (Sequence* s = dynamic_cast<Sequence*>(parent))
+	{
+		if (c == s->currentTime && s->isPlaying->boolValue()) return false; //objects affected by playing sequences are recomputed each frame
+	}
+
+	return true;
+}
+
 void BluxEngine::onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c)
 {
 	Engine::onControllableFeedbackUpdate(cc, c);
-	if (!isClearing && ObjectManager::getInstanceWithoutCreating() != nullptr && cc == ObjectManager::getInstance()) sendControllableData(c);
+	if (isClearing || ObjectManager::getInstanceWithoutCreating() == nullptr) return;
+
+	if (cc == ObjectManager::getInstance())
+	{
+		if (!batchVizUpdates) sendControllableData(c);
+		else if (c->type != Controllable::TRIGGER) addPendingVizParam((Parameter*)c);
+	}
+	else if (cc == GroupManager::getInstance() || cc == SceneManager::getInstance() || cc == GlobalEffectManager::getInstance() || cc == GlobalSequenceManager::getInstance() || cc == StageLayoutManager::getInstance())
+	{
+		if (!isValueAffectingFeedback(c)) return;
+		ObjectManager::getInstance()->setAllObjectsDirty(); //these can change the values of any object
+	}
 }
 
 void BluxEngine::clearInternal()
 {
+	clearVizAddresses();
+
 	ObjectManager::getInstance()->clear();
 	GroupManager::getInstance()->clear();
 	SceneManager::getInstance()->clear();
@@ -233,6 +418,17 @@ BluxSettings::BluxSettings() :
 {
 	defaultSceneLoadTime = addFloatParameter("Default Scene Load Time", "The default load time to set the scenes to on creation", 1, 0);
 	defaultSceneLoadTime->defaultUI = FloatParameter::TIME;
+	batchVizUpdates = addBoolParameter("Batch Viz Updates", "If checked, object changes are collected and sent to the viz clients as one binary message per update, only keeping the latest value of each parameter. Otherwise each change is sent as a JSON message.", false);
+	vizUpdateRate = addIntParameter("Viz Update Rate", "Number of batched updates sent to the viz clients per second", 30, 1, 100);
+}
+
+void BluxSettings::onContainerParameterChanged(Parameter* p)
+{
+	ControllableContainer::onContainerParameterChanged(p);
+	if (p == batchVizUpdates || p == vizUpdateRate)
+	{
+		if (BluxEngine* e = dynamic_cast<BluxEngine*>(Engine::mainEngine)) e->updateVizStreaming();
+	}
 }
 
 BluxSettings::~BluxSettings()
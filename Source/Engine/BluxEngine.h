@@ -12,7 +12,8 @@
 #include "JuceHeader.h"
 
 class BluxEngine : public Engine,
-    public SimpleWebSocketServer::Listener
+    public SimpleWebSocketServer::Listener,
+    public Timer
 {
 public:
     BluxEngine();
@@ -21,6 +22,26 @@ public:
     std::unique_ptr<SimpleWebSocketServer> vizServer;
     void initVizServer();
 
+    //batched viz streaming : changed parameters are collected and only their latest value is sent, in one binary message per tick
+    enum VizMessageType { VIZ_VALUES = 1 };
+    enum VizValueType { VIZ_FLOAT, VIZ_INT, VIZ_BOOL, VIZ_ARRAY, VIZ_STRING };
+
+    bool batchVizUpdates;
+    CriticalSection vizLock;
+    Array<WeakReference<Parameter>> pendingVizParams;
+    HashMap<Parameter*, bool> pendingVizParamsMap;
+    Array<WeakReference<Parameter>> vizAddressParams; //index is the id sent to the clients
+    HashMap<Parameter*, int> vizAddressIDs;
+    MemoryOutputStream vizBuffer;
+
+    void updateVizStreaming();
+    void addPendingVizParam(Parameter* p);
+    int getVizAddressID(Parameter* p, var& newAddresses);
+    var getVizAddresses();
+    void clearVizAddresses();
+    void flushVizUpdates();
+    void timerCallback() override;
+
     void connectionOpened(const String& id);
     void messageReceived(const String& id, const String& message);
 
@@ -49,4 +70,8 @@ public:
     ~BluxSettings();
 
     FloatParameter * defaultSceneLoadTime;
+    BoolParameter* batchVizUpdates;
+    IntParameter* vizUpdateRate;
+
+    void onContainerParameterChanged(Parameter* p) override;
 };
@@ -32,6 +32,8 @@ public:
     virtual void sendValuesForObject(Object* o);
     virtual void sendValuesForObjectInternal(Object* o) {}
     virtual void finishSendValues() {}
+    virtual void objectRemoved(Object* o) {} //called from the message thread, per object data kept for sending must be released here
+    virtual void objectComponentsChanged(Object* o) {} //same, for data resolved from the object's components
 
     virtual ControllableContainer* getInterfaceParams() { return new ControllableContainer("Interface parameters"); }
 
@@ -11,6 +11,7 @@
 #include "InterfaceIncludes.h"
 
 #include "Object/ObjectIncludes.h"
+#include "Scene/SceneIncludes.h"
 
 #include "Interface.cpp"
 #include "InterfaceManager.cpp"
@@ -24,6 +25,7 @@
 #include "interfaces/midi/MIDIInterface.cpp"
 #include "interfaces/midi/ui/MIDIMappingEditor.cpp"
 
+#include "interfaces/osc/OSCDispatcher.cpp"
 #include "interfaces/osc/OSCInterface.cpp"
 #include "interfaces/osc/custom/CustomOSCInterface.cpp"
 #include "interfaces/osc/ui/OSCInputEditor.cpp"
@@ -16,6 +16,7 @@
 #include "Interface.h"
 #include "ui/InterfaceUI.h"
 
+#include "interfaces/osc/OSCDispatcher.h"
 #include "interfaces/osc/OSCInterface.h"
 #include "interfaces/osc/ui/OSCInputEditor.h"
 #include "interfaces/osc/ui/OSCOutputEditor.h"
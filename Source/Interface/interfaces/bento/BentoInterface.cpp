@@ -8,65 +8,240 @@
   ==============================================================================
 */
 
+#if JUCE_LINUX
+#include <sys/socket.h>
+#include <netdb.h>
+#endif
+
 BentoInterface::BentoInterface() :
 	Interface(getTypeString())
 {
 	multiStripMode = addBoolParameter("Multi-strip Support", "If checked, this will prepend one byte containing the strip index to the udp color packet", true);
+
+#if JUCE_LINUX
+	startTimer(1000); //resolves hosts not seen yet and retries failed ones
+#endif
 }
 
 BentoInterface::~BentoInterface()
 {
+	stopTimer();
 }
 
 void BentoInterface::sendValuesForObjectInternal(Object* o)
 {
 	if (ColorComponent* colorComp = o->getComponent<ColorComponent>())
 	{
-		int numLeds = colorComp->resolution->intValue();
+		BentoInterfaceParams* bParams = dynamic_cast<BentoInterfaceParams*>(o->interfaceParameters.get());
+		if (bParams == nullptr) return;
 
-		HashMap<int, float> valueMap;
+		//outColors are already dimmed when the color uses the dimmer for opacity
 		float fac = 1;
-		if (DimmerComponent* ic = o->getComponent<DimmerComponent>())
+		if (!colorComp->useDimmerForOpacity->boolValue())
 		{
-			//ic->fillOutValueMap(valueMap, 0, true);
-			fac = valueMap[0];
+			if (DimmerComponent* ic = o->getComponent<DimmerComponent>())
+			{
+				if (ic->mainParameter != nullptr) fac = ic->mainParameter->floatValue();
+			}
 		}
 
-		//colorComp->fillOutValueMap(valueMap, 0, true);
+		GenericScopedLock lock(packetLock);
+		StripPacket* packet = stripPackets[o];
+		if (packet == nullptr)
+		{
+			packet = stripPacketPool.add(new StripPacket());
+			stripPackets.set(o, packet);
+		}
+
+		GenericScopedLock colorLock(colorComp->outColors.getLock());
+		const Colour* colors = colorComp->outColors.begin();
+		int numLeds = colorComp->outColors.size();
+		bool multiStrip = multiStripMode->boolValue();
+
+		//254 max, 255 is the end of packet marker
+		packet->data.resize((multiStrip ? 1 : 0) + numLeds * 3 + 1);
+		uint8* data = packet->data.getRawDataPointer();
+		if (multiStrip) *data++ = (uint8)bParams->stripIndex->intValue();
 
-		BentoInterfaceParams* bParams = dynamic_cast<BentoInterfaceParams*>(o->interfaceParameters.get());
-		
-		Array<uint8_t> data;
-		if (multiStripMode->boolValue()) data.add(bParams->stripIndex->intValue());
-		
 		for (int i = 0; i < numLeds; i++)
 		{
-			int index = i * 3;
-			data.add(valueMap[index] * fac * 254);
-			data.add(valueMap[index + 1] * fac * 254);
-			data.add(valueMap[index + 2] * fac * 254);
+			*data++ = (uint8)(colors[i].getFloatRed() * fac * 254);
+			*data++ = (uint8)(colors[i].getFloatGreen() * fac * 254);
+			*data++ = (uint8)(colors[i].getFloatBlue() * fac * 254);
 		}
+		*data = 255;
 
-		data.add(255);
+		packet->host = bParams->remoteHost->stringValue();
+		packetsToSend.add(packet);
+	}
+}
 
-		int dataSent = ledSender.write(bParams->remoteHost->stringValue(), remoteLedPort, data.getRawDataPointer(), data.size());
-		if (dataSent == -1)
+void BentoInterface::finishSendValues()
+{
+	GenericScopedLock lock(packetLock);
+	if (packetsToSend.isEmpty()) return;
+	sendPackets();
+	packetsToSend.clearQuick();
+}
+
+void BentoInterface::objectRemoved(Object* o)
+{
+	GenericScopedLock lock(packetLock);
+	if (StripPacket* packet = stripPackets[o])
+	{
+		stripPackets.remove(o);
+		packetsToSend.removeAllInstancesOf(packet);
+		stripPacketPool.removeObject(packet);
+	}
+}
+
+void BentoInterface::resolveHost(const String& host)
+{
+#if JUCE_LINUX
+	if (host.isEmpty()) return;
+
+	{
+		GenericScopedLock lock(resolvedHostsLock);
+		ResolvedHost* r = resolvedHosts[host];
+		if (r != nullptr && r->isValid) return;
+	}
+
+	//blocking, but only called from the message thread when a host changes or is retried
+	MemoryBlock address;
+	struct addrinfo hints = {};
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+
+	struct addrinfo* info = nullptr;
+	bool isValid = getaddrinfo(host.toRawUTF8(), String(remoteLedPort).toRawUTF8(), &hints, &info) == 0 && info != nullptr;
+	if (isValid) address.replaceAll(info->ai_addr, info->ai_addrlen);
+	if (info != nullptr) freeaddrinfo(info);
+
+	GenericScopedLock lock(resolvedHostsLock);
+	ResolvedHost* r = resolvedHosts[host];
+	if (r == nullptr)
+	{
+		r = resolvedHostPool.add(new ResolvedHost());
+		resolvedHosts.set(host, r);
+	}
+
+	r->isValid = isValid;
+	if (isValid)
+	{
+		r->address = address;
+		r->retryDelay = 0;
+	}
+	else
+	{
+		r->retryDelay = jlimit(1000, 30000, r->retryDelay * 2);
+		r->nextRetryTime = Time::getMillisecondCounter() + r->retryDelay;
+		NLOGWARNING(niceName, "Could not resolve " << host << ", retrying in " << r->retryDelay / 1000 << "s");
+	}
+#endif
+}
+
+BentoInterface::ResolvedHost* BentoInterface::getResolvedHost(const String& host)
+{
+	//called with resolvedHostsLock held, never resolves from the update thread
+	if (ResolvedHost* r = resolvedHosts[host]) return r;
+	pendingHosts.addIfNotAlreadyThere(host);
+	return nullptr;
+}
+
+void BentoInterface::timerCallback()
+{
+	StringArray hostsToResolve;
+	{
+		GenericScopedLock lock(resolvedHostsLock);
+		hostsToResolve.swapWith(pendingHosts);
+
+		uint32 now = Time::getMillisecondCounter();
+		HashMap<String, ResolvedHost*>::Iterator it(resolvedHosts);
+		while (it.next())
 		{
-			NLOGWARNING(niceName, "Could not send data to " << bParams->remoteHost->stringValue());
+			if (!it.getValue()->isValid && now >= it.getValue()->nextRetryTime) hostsToResolve.addIfNotAlreadyThere(it.getKey());
 		}
+	}
+
+	for (auto& h : hostsToResolve) resolveHost(h);
+}
+
+void BentoInterface::sendPackets()
+{
+	int totalBytes = 0;
+
+#if JUCE_LINUX
+	//one system call for all the strips of the frame
+	const int numPackets = packetsToSend.size();
+	messageHeaders.ensureSize(numPackets * sizeof(struct mmsghdr));
+	messageVectors.ensureSize(numPackets * sizeof(struct iovec));
+	messageHeaders.fillWith(0);
+	struct mmsghdr* messages = (struct mmsghdr*)messageHeaders.getData();
+	struct iovec* iovecs = (struct iovec*)messageVectors.getData();
+
+	GenericScopedLock hostsLock(resolvedHostsLock); //addresses are referenced until the packets are sent
+
+	int numMessages = 0;
+	for (auto& p : packetsToSend)
+	{
+		ResolvedHost* r = getResolvedHost(p->host);
+		if (r == nullptr || !r->isValid) continue;
 
-		if (logOutgoingData->boolValue())
+		iovecs[numMessages].iov_base = p->data.getRawDataPointer();
+		iovecs[numMessages].iov_len = (size_t)p->data.size();
+		messages[numMessages].msg_hdr.msg_name = r->address.getData();
+		messages[numMessages].msg_hdr.msg_namelen = (socklen_t)r->address.getSize();
+		messages[numMessages].msg_hdr.msg_iov = &iovecs[numMessages];
+		messages[numMessages].msg_hdr.msg_iovlen = 1;
+		numMessages++;
+	}
+
+	int numSent = 0;
+	while (numSent < numMessages)
+	{
+		int result = sendmmsg(ledSender.getRawSocketHandle(), messages + numSent, (unsigned int)(numMessages - numSent), 0);
+		if (result <= 0)
+		{
+			NLOGWARNING(niceName, "Could not send " << (numMessages - numSent) << " packets");
+			break;
+		}
+
+		for (int i = numSent; i < numSent + result; i++) totalBytes += (int)messages[i].msg_len;
+		numSent += result;
+	}
+#else
+	for (auto& p : packetsToSend)
+	{
+		int dataSent = ledSender.write(p->host, remoteLedPort, p->data.getRawDataPointer(), p->data.size());
+		if (dataSent == -1)
 		{
-			NLOG(niceName, "Sent " << dataSent << " bytes");
+			NLOGWARNING(niceName, "Could not send data to " << p->host);
+			continue;
 		}
+		totalBytes += dataSent;
+	}
+#endif
+
+	if (logOutgoingData->boolValue())
+	{
+		NLOG(niceName, "Sent " << totalBytes << " bytes in " << packetsToSend.size() << " packets");
 	}
 }
 
 
-BentoInterface::BentoInterfaceParams::BentoInterfaceParams() :
-	ControllableContainer("Interface Parameters")
+BentoInterface::BentoInterfaceParams::BentoInterfaceParams(BentoInterface* i) :
+	ControllableContainer("Interface Parameters"),
+	itf(i)
 {
 	remoteHost = addStringParameter("Remote Host", "IP of the prop on the network", "192.168.0.100");
 	//sendRate = addIntParameter("Send Rate", "Frequency at which to send the colors", 40, 1, 200);
 	stripIndex = addIntParameter("Strip Index", "The index of the strip to control", 1, 1, 8);
+
+	if (itf != nullptr) itf->resolveHost(remoteHost->stringValue());
+}
+
+void BentoInterface::BentoInterfaceParams::onContainerParameterChanged(Parameter* p)
+{
+	ControllableContainer::onContainerParameterChanged(p);
+	if (p == remoteHost && itf != nullptr) itf->resolveHost(remoteHost->stringValue());
 }
@@ -11,7 +11,8 @@
 #pragma once
 
 class BentoInterface :
-    public Interface
+    public Interface,
+    public Timer
 {
 public:
     BentoInterface();
@@ -25,19 +26,58 @@ public:
     DatagramSocket ledSender;
     OSCSender oscSender;
 
+    //packets are filled during the update and all sent at once in finishSendValues
+    struct StripPacket
+    {
+        Array<uint8> data;
+        String host;
+    };
+
+    //hosts are resolved on the message thread when they are set, failed ones are retried with an increasing delay
+    struct ResolvedHost
+    {
+        MemoryBlock address; //raw socket address
+        bool isValid = false;
+        int retryDelay = 0;
+        uint32 nextRetryTime = 0;
+    };
+
+    HashMap<Object*, StripPacket*> stripPackets;
+    OwnedArray<StripPacket> stripPacketPool;
+    Array<StripPacket*> packetsToSend;
+    CriticalSection packetLock; //packets are filled and sent from the update thread, and released from the message thread
+    HashMap<String, ResolvedHost*> resolvedHosts;
+    OwnedArray<ResolvedHost> resolvedHostPool;
+    StringArray pendingHosts; //seen by the update thread before being resolved
+    CriticalSection resolvedHostsLock;
+    MemoryBlock messageHeaders; //batched send buffers, kept between frames
+    MemoryBlock messageVectors;
+
     void sendValuesForObjectInternal(Object* o) override;
+    void finishSendValues() override;
+    void objectRemoved(Object* o) override;
+
+    void resolveHost(const String& host);
+    ResolvedHost* getResolvedHost(const String& host);
+    void sendPackets();
+
+    void timerCallback() override;
 
     class BentoInterfaceParams : public ControllableContainer
     {
     public:
-        BentoInterfaceParams();
+        BentoInterfaceParams(BentoInterface* i = nullptr);
+
+        BentoInterface* itf;
 
         StringParameter* remoteHost;
         //IntParameter* sendRate;
         IntParameter* stripIndex;
+
+        void onContainerParameterChanged(Parameter* p) override;
     };
 
-    ControllableContainer* getInterfaceParams() override { return new BentoInterfaceParams(); }
+    ControllableContainer* getInterfaceParams() override { return new BentoInterfaceParams(this); }
 
     String getTypeString() const override { return "Bento"; }
     static BentoInterface* create(var params) { return new BentoInterface(); };
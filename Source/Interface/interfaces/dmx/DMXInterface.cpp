@@ -15,6 +15,10 @@
 DMXInterface::DMXInterface() :
 	Interface(getTypeString()),
 	Thread("DMX Interface"),
+	sharedBufferState(1),
+	writeBufferIndex(0),
+	readBufferIndex(2),
+	writeBufferWasDropped(false),
 	dmxInterfaceNotifier(20)
 {
 	dmxType = addEnumParameter("DMX Type", "Choose the type of dmx interface you want to connect");
@@ -175,50 +179,71 @@ void DMXInterface::sendValuesForObjectInternal(Object* o)
 
 	int channelOffset = dmxParams->startChannel->intValue() - 1; //channelOffset is zero based to fill the universe array
 
-	var params(new DynamicObject());
-	params.getDynamicObject()->setProperty("channelOffset", channelOffset);
-
 	//Store these channels in local universe
 	int net = dmxParams->net->enabled ? dmxParams->net->intValue() : defaultNet->intValue();
 	int subnet = dmxParams->subnet->enabled ? dmxParams->subnet->intValue() : defaultSubnet->intValue();
 	int universe = dmxParams->universe->enabled ? dmxParams->universe->intValue() : defaultUniverse->intValue();
 	DMXUniverse* u = getUniverse(net, subnet, universe);
 
-
-	var channelsData;
-	channelsData.resize(DMX_NUM_CHANNELS);
-	for (int i = 0; i < u->values.size(); i++) channelsData[i] = u->values[i];
-
-	var data(new DynamicObject());
-	data.getDynamicObject()->setProperty("channels", channelsData);
+	//components write their mapped values directly in a copy of the universe channels, then only changed channels are updated
+	const int numUniverseChannels = jmin(u->values.size(), DMX_NUM_CHANNELS);
+	uint8 channels[DMX_NUM_CHANNELS];
+	zeromem(channels, DMX_NUM_CHANNELS);
+	memcpy(channels, u->values.getRawDataPointer(), numUniverseChannels);
 
 	for (auto& c : o->componentManager->items)
 	{
 		if (!c->enabled->boolValue()) continue;
-		c->fillInterfaceData(this, data, params);// , compValues, startChannel);
+		c->fillInterfaceData(this, channels, channelOffset);
 	}
 
 
 	//outActivityTrigger->trigger();
 
 	bool sOnChangeOnly = sendOnChangeOnly->boolValue();
+	bool logOutgoing = logOutgoingData->boolValue();
+	const uint8* currentValues = u->values.getRawDataPointer();
 
-	for (int i = 0; i < channelsData.size(); i++)
+	for (int i = 0; i < DMX_NUM_CHANNELS; i++)
 	{
-		if (logOutgoingData->boolValue()) NLOG(niceName, String(i + 1) << " : " << (int)(channelsData[i]));
-		u->updateValue(i, (int)channelsData[i], sOnChangeOnly);
+		if (logOutgoing) NLOG(niceName, String(i + 1) << " : " << (int)channels[i]);
+		if (i < numUniverseChannels && channels[i] == currentValues[i]) continue;
+		u->updateValue(i, channels[i], sOnChangeOnly);
 	}
 }
 
 void DMXInterface::finishSendValues()
 {
-	GenericScopedLock lock(universesToSend.getLock());
-	universesToSend.clear();
-	for (auto& u : universes)
+	OwnedArray<DMXUniverse>& buffer = universeBuffers[writeBufferIndex];
+
+	//universe objects are reused, allocation only happens when the number of universes changes
+	if (buffer.size() > universes.size()) buffer.removeLast(buffer.size() - universes.size());
+
+	for (int i = 0; i < universes.size(); i++)
 	{
-		universesToSend.add(new DMXUniverse(u));
+		DMXUniverse* u = universes.getUnchecked(i);
+		if (i >= buffer.size())
+		{
+			buffer.add(new DMXUniverse(u));
+			u->isDirty = false;
+			continue;
+		}
+
+		DMXUniverse* bu = buffer.getUnchecked(i);
+		bool sameUniverse = bu->net == u->net && bu->subnet == u->subnet && bu->universe == u->universe;
+
+		bu->net = u->net;
+		bu->subnet = u->subnet;
+		bu->universe = u->universe;
+		bu->isDirty = u->isDirty || (writeBufferWasDropped && sameUniverse && bu->isDirty);
+		memcpy(bu->values.getRawDataPointer(), u->values.getRawDataPointer(), jmin(bu->values.size(), u->values.size()));
+
 		u->isDirty = false;
 	}
+
+	int previousState = sharedBufferState.exchange(writeBufferIndex | NEW_BUFFER_FLAG);
+	writeBufferIndex = previousState & ~NEW_BUFFER_FLAG;
+	writeBufferWasDropped = (previousState & NEW_BUFFER_FLAG) != 0;
 }
 
 
@@ -247,8 +272,10 @@ void DMXInterface::run()
 
 			bool sendOnChange = sendOnChangeOnly->boolValue();
 
-			GenericScopedLock lock(universesToSend.getLock());
-			for (auto& u : universesToSend)
+			//pick the last published buffer if there is a new one, otherwise resend the current one
+			if (sharedBufferState.get() & NEW_BUFFER_FLAG) readBufferIndex = sharedBufferState.exchange(readBufferIndex) & ~NEW_BUFFER_FLAG;
+
+			for (auto& u : universeBuffers[readBufferIndex])
 			{
 				if (sendOnChange && !u->isDirty) continue;
 				{
@@ -263,8 +290,11 @@ void DMXInterface::run()
 					NLOG(niceName, "Sending Universe " << u->toString());
 				}
 
-				Array<uint8> values(u->values.getRawDataPointer(), u->values.size());
-				dmxInterfaceNotifier.addMessage(new DMXInterfaceEvent(DMXInterfaceEvent::UNIVERSE_SENT, u, values));
+				if (numAsyncListeners.get() > 0)
+				{
+					Array<uint8> values(u->values.getRawDataPointer(), u->values.size());
+					dmxInterfaceNotifier.addMessage(new DMXInterfaceEvent(DMXInterfaceEvent::UNIVERSE_SENT, u, values));
+				}
 
 			}
 		}
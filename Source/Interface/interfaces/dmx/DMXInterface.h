@@ -40,7 +40,15 @@ public:
 	OwnedArray<DMXUniverse> universes;
 	HashMap<int, DMXUniverse*> universeIdMap; //internally used
 
-	OwnedArray<DMXUniverse, CriticalSection> universesToSend;
+	//triple buffer between the update thread (writing) and the send thread (reading), so neither has to lock or wait for the other
+	enum { NEW_BUFFER_FLAG = 4 };
+	OwnedArray<DMXUniverse> universeBuffers[3];
+	Atomic<int> sharedBufferState; //index of the last published buffer, with NEW_BUFFER_FLAG if the send thread hasn't picked it yet
+	int writeBufferIndex; //only used by the update thread
+	int readBufferIndex; //only used by the send thread
+	bool writeBufferWasDropped; //the write buffer was published but never sent, its dirty flags must be kept
+
+	Atomic<int> numAsyncListeners; //avoid copying sent universes for the UI when nobody listens
 
 	void clearItem() override;
 
@@ -106,9 +114,9 @@ public:
 	QueuedNotifier<DMXInterfaceEvent> dmxInterfaceNotifier;
 	typedef QueuedNotifier<DMXInterfaceEvent>::Listener AsyncListener;
 
-	void addAsyncDMXInterfaceListener(AsyncListener* newListener) { dmxInterfaceNotifier.addListener(newListener); }
-	void addAsyncCoalescedDMXInterfaceListener(AsyncListener* newListener) { dmxInterfaceNotifier.addAsyncCoalescedListener(newListener); }
-	void removeAsyncDMXInterfaceListener(AsyncListener* listener) { dmxInterfaceNotifier.removeListener(listener); }
+	void addAsyncDMXInterfaceListener(AsyncListener* newListener) { dmxInterfaceNotifier.addListener(newListener); ++numAsyncListeners; }
+	void addAsyncCoalescedDMXInterfaceListener(AsyncListener* newListener) { dmxInterfaceNotifier.addAsyncCoalescedListener(newListener); ++numAsyncListeners; }
+	void removeAsyncDMXInterfaceListener(AsyncListener* listener) { dmxInterfaceNotifier.removeListener(listener); --numAsyncListeners; }
 
 
 	DECLARE_TYPE("DMX");
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+	OSCDispatcher.cpp
+	Created: 18 Oct 2026 2:37:08pm
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Interface/InterfaceIncludes.h"
+
+OSCDispatcher::OSCDispatcher()
+{
+}
+
+OSCDispatcher::~OSCDispatcher()
+{
+}
+
+void OSCDispatcher::addHandler(const OSCAddressPattern& pattern, Handler handler)
+{
+	GenericScopedLock sl(lock);
+
+	Entry* e = entries.add(new Entry({ pattern, handler }));
+
+	StringArray segments;
+	segments.addTokens(pattern.toString(), "/", "");
+	segments.removeEmptyStrings();
+
+	Node* n = &root;
+	for (auto& s : segments)
+	{
+		if (s.containsAnyOf("*?[]{}"))
+		{
+			n->patternEntries.add(e);
+			return;
+		}
+
+		Node* child = n->children[s];
+		if (child == nullptr)
+		{
+			child = n->ownedChildren.add(new Node());
+			n->children.set(s, child);
+		}
+		n = child;
+	}
+
+	n->exactEntries.add(e);
+}
+
+int OSCDispatcher::dispatch(const OSCMessage& m, const Array<var>& params)
+{
+	{
+		GenericScopedLock sl(lock);
+		collectMatches(m);
+	}
+
+	//called outside the lock so handlers can register new addresses
+	for (auto& e : matches) e->handler(m, params);
+	return matches.size();
+}
+
+void OSCDispatcher::collectMatches(const OSCMessage& m)
+{
+	matches.clearQuick();
+
+	const OSCAddressPattern& address = m.getAddressPattern();
+
+	//incoming patterns are rare, they're matched against every literal address
+	if (address.containsWildcards())
+	{
+		for (auto& e : entries)
+		{
+			if (!e->pattern.containsWildcards() && address.matches(OSCAddress(e->pattern.toString()))) matches.add(e);
+		}
+		return;
+	}
+
+	String addressString = address.toString();
+	std::unique_ptr<OSCAddress> oscAddress; //only built if a wildcard pattern needs to be checked
+
+	Node* n = &root;
+	int start = 1;
+	while (n != nullptr)
+	{
+		for (auto& e : n->patternEntries)
+		{
+			if (oscAddress == nullptr) oscAddress.reset(new OSCAddress(addressString));
+			if (e->pattern.matches(*oscAddress)) matches.add(e);
+		}
+
+		if (start > addressString.length())
+		{
+			matches.addArray(n->exactEntries);
+			break;
+		}
+
+		int end = addressString.indexOfChar(start, '/');
+		if (end == -1) end = addressString.length();
+
+		n = n->children[addressString.substring(start, end)];
+		start = end + 1;
+	}
+}
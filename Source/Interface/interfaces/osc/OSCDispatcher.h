@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+	OSCDispatcher.h
+	Created: 18 Oct 2026 2:37:08pm
+	Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class OSCDispatcher
+{
+public:
+	OSCDispatcher();
+	~OSCDispatcher();
+
+	typedef std::function<void(const OSCMessage&, const Array<var>&)> Handler;
+
+	void addHandler(const OSCAddressPattern& pattern, Handler handler);
+	int dispatch(const OSCMessage& m, const Array<var>& params); //returns the number of handlers called
+
+private:
+	struct Entry
+	{
+		OSCAddressPattern pattern;
+		Handler handler;
+	};
+
+	//Literal segments are indexed by name, patterns with wildcards are kept on the node of their literal prefix
+	struct Node
+	{
+		HashMap<String, Node*> children;
+		OwnedArray<Node> ownedChildren;
+		Array<Entry*> exactEntries;
+		Array<Entry*> patternEntries;
+	};
+
+	Node root;
+	OwnedArray<Entry> entries;
+	Array<Entry*> matches; //only used by the dispatching thread
+	CriticalSection lock;
+
+	void collectMatches(const OSCMessage& m);
+};
@@ -14,6 +14,8 @@ OSCInterface::OSCInterface(const String& name, bool canHaveScripts) :
 	Interface(name, canHaveScripts),
 	Thread("OSCZeroconf"),
 	localPort(nullptr),
+	lastPacketTarget(nullptr),
+	inboundFifo(INBOUND_QUEUE_SIZE),
 	servus("_osc._udp"),
 	receiveCC(nullptr)
 {
@@ -23,8 +25,15 @@ OSCInterface::OSCInterface(const String& name, bool canHaveScripts) :
 
 	localPort = receiveCC->addIntParameter("Local Port", "Local Port to bind to receive OSC Messages", 13000, 1024, 65535);
 	localPort->warningResolveInspectable = this;
+	engineCommands = receiveCC->addBoolParameter("Engine Commands", "If checked, engine addresses like /scenes/loadScene are also handled when received on this interface", false);
+
+	inboundMessages.insertMultiple(0, OSCMessage(OSCAddressPattern("/blux")), INBOUND_QUEUE_SIZE);
+	registerEngineAddresses();
 
 	useBundles = addBoolParameter("Use Bundles", "If checked, this will pack all objects into bundles", false);
+	framePackets = addBoolParameter("Frame Packets", "If checked, all messages of a frame are encoded directly into one bundle per destination, split to fit the max packet size. This is faster than Use Bundles when sending a lot of values", false);
+	maxPacketSize = addIntParameter("Max Packet Size", "Maximum size in bytes of a frame packet. Keep it under the network MTU to avoid fragmentation", 1400, 64, 65507);
+	maxPacketSize->setEnabled(framePackets->boolValue());
 
 	receiver.registerFormatErrorHandler(&OSCHelpers::logOSCFormatError);
 	receiver.addListener(this);
@@ -107,6 +116,48 @@ void OSCInterface::setupReceiver()
 }
 
 
+void OSCInterface::queueMessage(const OSCMessage& msg)
+{
+	int start1, size1, start2, size2;
+	inboundFifo.prepareToWrite(1, start1, size1, start2, size2);
+	if (size1 + size2 == 0)
+	{
+		droppedMessages += 1;
+		return;
+	}
+
+	inboundMessages.getReference(size1 > 0 ? start1 : start2) = msg;
+	inboundFifo.finishedWrite(1);
+}
+
+void OSCInterface::processInboundMessages()
+{
+	int numReady = inboundFifo.getNumReady();
+	if (numReady == 0) return;
+
+	int start1, size1, start2, size2;
+	inboundFifo.prepareToRead(numReady, start1, size1, start2, size2);
+	for (int i = 0; i < size1; i++) processMessage(inboundMessages.getReference(start1 + i));
+	for (int i = 0; i < size2; i++) processMessage(inboundMessages.getReference(start2 + i));
+	inboundFifo.finishedRead(size1 + size2);
+
+	int dropped = droppedMessages.exchange(0);
+	if (dropped > 0) NLOGWARNING(niceName, dropped << " incoming messages dropped, the input queue is full");
+}
+
+void OSCInterface::prepareSendValues()
+{
+	processInboundMessages();
+}
+
+void OSCInterface::registerEngineAddresses()
+{
+	dispatcher.addHandler(OSCAddressPattern("/scenes/loadScene"), [this](const OSCMessage& m, const Array<var>&)
+		{
+			if (engineCommands->boolValue()) SceneManager::getInstance()->processMessage(m, niceName);
+		});
+}
+
 void OSCInterface::processMessage(const OSCMessage& msg)
 {
 	inActivityTrigger->trigger();
@@ -119,19 +170,17 @@ void OSCInterface::processMessage(const OSCMessage& msg)
 
 	processMessageInternal(msg);
 
+	Array<var> params;
 	if (scriptManager->items.size() > 0)
 	{
-		Array<var> params;
 		params.add(msg.getAddressPattern().toString());
 		var args = var(Array<var>()); //initialize force array
 		for (auto& a : msg) args.append(OSCHelpers::argumentToVar(a));
 		params.add(args);
 		scriptManager->callFunctionOnAllItems(oscEventId, params);
-
-		for (auto& entry : scriptCallbacks)
-			if (std::get<0>(entry).matches(msg.getAddressPattern().toString()))
-				scriptManager->callFunctionOnAllItems(std::get<1>(entry), params);
 	}
+
+	dispatcher.dispatch(msg, params);
 }
 
 void OSCInterface::processMessageInternal(const OSCMessage& m)
@@ -164,7 +213,11 @@ void OSCInterface::sendOSC(const OSCMessage& msg, String ip, int port)
 
 	outActivityTrigger->trigger();
 
-	if (useBundles->boolValue())
+	if (framePackets->boolValue())
+	{
+		addMessageToPacket(msg, ip, port);
+	}
+	else if (useBundles->boolValue())
 	{
 		String ipp = ip + ":" + String(port);
 
@@ -212,6 +265,8 @@ void OSCInterface::sendOSC(const OSCMessage& msg, String ip, int port)
 
 void OSCInterface::finishSendValues()
 {
+	sendPackets(); //also flushes what is left when the mode has just been switched off
+
 	if (useBundles->boolValue())
 	{
 		if (bundles.size() > 0)
@@ -237,6 +292,148 @@ void OSCInterface::finishSendValues()
 	}
 }
 
+void OSCInterface::addMessageToPacket(const OSCMessage& msg, const String& ip, int port)
+{
+	GenericScopedLock lock(packetLock);
+
+	messageBuffer.reset();
+	try
+	{
+		encodeMessage(msg, messageBuffer);
+	}
+	catch (OSCFormatError& e)
+	{
+		NLOGERROR(niceName, "Error encoding message : " << e.description);
+		return;
+	}
+
+	PacketTarget* t = getPacketTarget(ip, port);
+
+	const int elementSize = 4 + (int)messageBuffer.getDataSize();
+	if (t->numElements > 0 && (int)t->packet.getDataSize() + elementSize > maxPacketSize->intValue()) flushPacketTarget(t);
+
+	if (t->numElements == 0)
+	{
+		t->packet.write("#bundle", 8); //includes the null terminator
+		t->packet.writeInt64BigEndian(1); //immediate time tag
+	}
+
+	t->packet.writeIntBigEndian((int)messageBuffer.getDataSize());
+	t->packet.write(messageBuffer.getData(), messageBuffer.getDataSize());
+	t->numElements++;
+
+	if (logOutgoingData->boolValue())
+	{
+		NLOG(niceName, "Add " << msg.getAddressPattern().toString() << " to frame packet " << (t == &defaultTarget ? String("(outputs)") : ip + ":" + String(port)) << " : " << t->numElements << " messages");
+	}
+}
+
+OSCInterface::PacketTarget* OSCInterface::getPacketTarget(const String& ip, int port)
+{
+	if (ip.isEmpty() || port <= 0) return &defaultTarget;
+	if (lastPacketTarget != nullptr && lastPacketTarget->port == port && lastPacketTarget->ip == ip) return lastPacketTarget;
+
+	for (auto& t : packetTargets)
+	{
+		if (t->port == port && t->ip == ip)
+		{
+			lastPacketTarget = t;
+			return t;
+		}
+	}
+
+	PacketTarget* t = new PacketTarget();
+	t->ip = ip;
+	t->port = port;
+	packetTargets.add(t);
+	lastPacketTarget = t;
+	return t;
+}
+
+void OSCInterface::encodeMessage(const OSCMessage& msg, MemoryOutputStream& out)
+{
+	//address pattern and type tags only change when the script changes, they're encoded once and reused
+	const String& address = msg.getAddressPattern().toString();
+	EncodedHeader* h = headerCache[address];
+	if (h == nullptr)
+	{
+		if (headers.size() < MAX_CACHED_HEADERS) h = headers.add(new EncodedHeader());
+		else
+		{
+			h = headers[nextEvictedHeader];
+			nextEvictedHeader = (nextEvictedHeader + 1) % MAX_CACHED_HEADERS;
+			headerCache.remove(h->address);
+			h->data.reset();
+		}
+
+		h->address = address;
+		headerCache.set(address, h);
+	}
+
+	bool typeTagsChanged = h->typeTags.size() != msg.size();
+	for (int i = 0; i < msg.size() && !typeTagsChanged; i++) typeTagsChanged = h->typeTags.getUnchecked(i) != msg[i].getType();
+
+	if (h->data.getSize() == 0 || typeTagsChanged)
+	{
+		h->typeTags.clearQuick();
+		for (auto& a : msg) h->typeTags.add(a.getType());
+
+		MemoryOutputStream hs(h->data, false); //trims the block to the written size when destroyed
+		hs.writeString(address);
+		hs.writeRepeatedByte(0, 3 - (address.getNumBytesAsUTF8() % 4));
+		hs.writeByte(',');
+		hs.write(h->typeTags.getRawDataPointer(), (size_t)h->typeTags.size());
+		hs.writeRepeatedByte(0, 4 - ((1 + h->typeTags.size()) % 4));
+	}
+
+	out.write(h->data.getData(), h->data.getSize());
+
+	for (auto& a : msg)
+	{
+		if (a.isFloat32()) out.writeFloatBigEndian(a.getFloat32());
+		else if (a.isInt32()) out.writeIntBigEndian(a.getInt32());
+		else if (a.isColour()) out.writeIntBigEndian((int)a.getColour().toInt32());
+		else if (a.isString())
+		{
+			String s = a.getString();
+			out.writeString(s);
+			out.writeRepeatedByte(0, 3 - (s.getNumBytesAsUTF8() % 4));
+		}
+		else if (a.isBlob())
+		{
+			const MemoryBlock& b = a.getBlob();
+			out.writeIntBigEndian((int)b.getSize());
+			out.write(b.getData(), b.getSize());
+			out.writeRepeatedByte(0, (4 - (b.getSize() % 4)) % 4);
+		}
+	}
+}
+
+void OSCInterface::flushPacketTarget(PacketTarget* t)
+{
+	if (t->numElements == 0) return;
+
+	if (t == &defaultTarget)
+	{
+		for (auto& o : outputManager->items) o->sendPacket(t->packet.getData(), t->packet.getDataSize());
+	}
+	else
+	{
+		packetSocket.write(t->ip, t->port, t->packet.getData(), (int)t->packet.getDataSize());
+	}
+
+	t->packet.reset();
+	t->numElements = 0;
+}
+
+void OSCInterface::sendPackets()
+{
+	GenericScopedLock lock(packetLock);
+
+	flushPacketTarget(&defaultTarget);
+	for (auto& t : packetTargets) flushPacketTarget(t);
+}
+
 
 void OSCInterface::setupZeroConf()
 {
@@ -376,6 +573,10 @@ var OSCInterface::registerOSCCallbackFromScript(const var::NativeFunctionArgs& a
 				return var();
 
 		m->scriptCallbacks.add(std::make_tuple(pattern, callbackName));
+		m->dispatcher.addHandler(pattern, [m, callbackName](const OSCMessage&, const Array<var>& params)
+			{
+				if (params.size() > 0) m->scriptManager->callFunctionOnAllItems(callbackName, params);
+			});
 	}
 	catch (OSCFormatError& e)
 	{
@@ -431,12 +632,16 @@ void OSCInterface::onControllableFeedbackUpdateInternal(ControllableContainer* c
 	{
 		if (!isCurrentlyLoadingData) setupReceiver();
 	}
+	else if (c == framePackets)
+	{
+		maxPacketSize->setEnabled(framePackets->boolValue());
+	}
 }
 
 void OSCInterface::oscMessageReceived(const OSCMessage& message)
 {
 	if (!enabled->boolValue()) return;
-	processMessage(message);
+	queueMessage(message);
 }
 
 void OSCInterface::oscBundleReceived(const OSCBundle& bundle)
@@ -444,7 +649,8 @@ void OSCInterface::oscBundleReceived(const OSCBundle& bundle)
 	if (!enabled->boolValue()) return;
 	for (auto& m : bundle)
 	{
-		processMessage(m.getMessage());
+		if (m.isMessage()) queueMessage(m.getMessage());
+		else if (m.isBundle()) oscBundleReceived(m.getBundle());
 	}
 }
 
@@ -460,7 +666,8 @@ OSCOutput::OSCOutput() :
 	BaseItem("OSC Output"),
 	Thread("OSC output"),
 	forceDisabled(false),
-	senderIsConnected(false)
+	senderIsConnected(false),
+	targetPort(0)
 {
 	isSelectable = false;
 
@@ -518,16 +725,14 @@ void OSCOutput::setupSender()
 	if (isThreadRunning())
 	{
 		stopThread(1000);
-		// Clear queue
-		const ScopedLock sl(queueLock);
-		while (!messageQueue.empty())
-			messageQueue.pop();
+		clearQueues();
 	}
 
 	if (!enabled->boolValue() || forceDisabled || Engine::mainEngine->isClearing) return;
 
-	String targetHost = useLocal->boolValue() ? "127.0.0.1" : remoteHost->stringValue();
-	senderIsConnected = sender.connect(targetHost, remotePort->intValue());
+	targetHost = useLocal->boolValue() ? "127.0.0.1" : remoteHost->stringValue();
+	targetPort = remotePort->intValue();
+	senderIsConnected = sender.connect(targetHost, targetPort);
 	if (senderIsConnected)
 	{
 		startThread();
@@ -563,50 +768,48 @@ void OSCOutput::sendOSC(const OSCBundle& m)
 	notify();
 }
 
-void OSCOutput::run()
+void OSCOutput::sendPacket(const void* data, size_t size)
 {
-	while (!Engine::mainEngine->isClearing && !threadShouldExit())
+	if (!enabled->boolValue() || forceDisabled || !senderIsConnected) return;
 	{
-		bool sent = false;
+		const ScopedLock sl(queueLock);
+		packetQueue.emplace(data, size);
+	}
+	notify();
+}
 
-		std::unique_ptr<OSCMessage> msgToSend;
-		{
-			const ScopedLock sl(queueLock);
-			if (!messageQueue.empty())
-			{
-				msgToSend = std::move(messageQueue.front());
-				messageQueue.pop();
-			}
-		}
+void OSCOutput::clearQueues()
+{
+	const ScopedLock sl(queueLock);
+	std::queue<std::unique_ptr<OSCMessage>>().swap(messageQueue);
+	std::queue<std::unique_ptr<OSCBundle>>().swap(bundleQueue);
+	std::queue<MemoryBlock>().swap(packetQueue);
+}
 
-		if (msgToSend)
-		{
-			sent = true;
-			sender.send(*msgToSend);
-		}
+void OSCOutput::run()
+{
+	std::queue<std::unique_ptr<OSCMessage>> messagesToSend;
+	std::queue<std::unique_ptr<OSCBundle>> bundlesToSend;
+	std::queue<MemoryBlock> packetsToSend;
 
-		std::unique_ptr<OSCBundle> bundleToSend;
+	while (!Engine::mainEngine->isClearing && !threadShouldExit())
+	{
+		//take everything that has been queued since the last pass, so a whole frame is sent without going back to the lock
 		{
 			const ScopedLock sl(queueLock);
-			if (!bundleQueue.empty())
-			{
-				bundleToSend = std::move(bundleQueue.front());
-				bundleQueue.pop();
-			}
+			messagesToSend.swap(messageQueue);
+			bundlesToSend.swap(bundleQueue);
+			packetsToSend.swap(packetQueue);
 		}
 
-		if (bundleToSend)
-		{
-			sent = true;
-			sender.send(*bundleToSend);
-		}
+		bool sent = !messagesToSend.empty() || !bundlesToSend.empty() || !packetsToSend.empty();
 
+		for (; !messagesToSend.empty(); messagesToSend.pop()) sender.send(*messagesToSend.front());
+		for (; !bundlesToSend.empty(); bundlesToSend.pop()) sender.send(*bundlesToSend.front());
+		for (; !packetsToSend.empty(); packetsToSend.pop()) packetSocket.write(targetHost, targetPort, packetsToSend.front().getData(), (int)packetsToSend.front().getSize());
 
 		if (!sent) wait(1000); // notify() is called when a message is added to the queue
 	}
 
-	// Clear queue
-	const ScopedLock sl(queueLock);
-	while (!messageQueue.empty())
-		messageQueue.pop();
+	clearQueues();
 }
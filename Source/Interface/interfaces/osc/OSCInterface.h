@@ -34,6 +34,9 @@ public:
 	virtual void setupSender();
 	void sendOSC(const OSCMessage& m);
 	void sendOSC(const OSCBundle& m);
+	void sendPacket(const void* data, size_t size); //already encoded OSC data, written as is
+
+	void clearQueues();
 
 	virtual void run() override;
 
@@ -43,8 +46,13 @@ public:
 
 private:
 	OSCSender sender;
+	DatagramSocket packetSocket;
+	String targetHost;
+	int targetPort;
+
 	std::queue<std::unique_ptr<OSCMessage>> messageQueue;
 	std::queue<std::unique_ptr<OSCBundle>> bundleQueue;
+	std::queue<MemoryBlock> packetQueue;
 	CriticalSection queueLock;
 };
 
@@ -62,6 +70,7 @@ public:
 	IntParameter* localPort;
 	BoolParameter* isConnected;
 	BoolParameter* useBundles;
+	BoolParameter* engineCommands;
 
 	OSCReceiver receiver;
 	OSCSender genericSender;
@@ -76,6 +85,36 @@ public:
 	OwnedArray<BundleTarget> bundles;
 	HashMap<String, BundleTarget *> bundleMap;
 
+	//Frame packets : messages are encoded directly into one bundle per destination, split at the max packet size
+	BoolParameter* framePackets;
+	IntParameter* maxPacketSize;
+
+	struct PacketTarget
+	{
+		String ip = "";
+		int port = 0;
+		MemoryOutputStream packet;
+		int numElements = 0;
+	};
+
+	struct EncodedHeader
+	{
+		String address;
+		Array<OSCType> typeTags;
+		MemoryBlock data; //padded address pattern + padded type tags
+	};
+
+	PacketTarget defaultTarget; //sent through the outputs
+	OwnedArray<PacketTarget> packetTargets;
+	PacketTarget* lastPacketTarget;
+	static const int MAX_CACHED_HEADERS = 8192; //scripts generating addresses on the fly, don't grow forever
+	HashMap<String, EncodedHeader*> headerCache;
+	OwnedArray<EncodedHeader> headers;
+	int nextEvictedHeader = 0; //once full, headers are recycled in insertion order
+	MemoryOutputStream messageBuffer;
+	DatagramSocket packetSocket;
+	CriticalSection packetLock;
+
 	//ZEROCONF
 
 	Servus servus;
@@ -87,8 +126,21 @@ public:
 	const Identifier oscEventId = "oscEvent";
 
 	//RECEIVE
+	//Messages are pushed by the receiver thread and processed on the update thread at the start of each frame
+	static const int INBOUND_QUEUE_SIZE = 4096;
+	AbstractFifo inboundFifo;
+	Array<OSCMessage> inboundMessages;
+	Atomic<int> droppedMessages;
+
+	OSCDispatcher dispatcher;
+
 	virtual void setupReceiver();
 
+	void queueMessage(const OSCMessage& msg);
+	void processInboundMessages();
+	virtual void prepareSendValues() override;
+
+	void registerEngineAddresses();
 	void processMessage(const OSCMessage& msg);
 	virtual void processMessageInternal(const OSCMessage&);
 
@@ -100,6 +152,12 @@ public:
 	virtual void sendOSC(const OSCMessage& msg, String ip = "", int port = 0);
 	virtual void finishSendValues() override;
 
+	void addMessageToPacket(const OSCMessage& msg, const String& ip, int port);
+	PacketTarget* getPacketTarget(const String& ip, int port);
+	void encodeMessage(const OSCMessage& msg, MemoryOutputStream& out);
+	void flushPacketTarget(PacketTarget* t);
+	void sendPackets();
+
 	//ZEROCONF
 	void setupZeroConf();
 
@@ -123,5 +181,5 @@ public:
 	static OSCInterface* create(var params) { return new OSCInterface(); };
 
 private:
-	Array<std::tuple<OSCAddressPattern, Identifier>> scriptCallbacks;
+	Array<std::tuple<OSCAddressPattern, Identifier>> scriptCallbacks; //kept to avoid registering the same callback twice
 };
\ No newline at end of file
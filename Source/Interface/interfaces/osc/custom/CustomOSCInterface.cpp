@@ -13,8 +13,11 @@
 
 CustomOSCInterface::CustomOSCInterface() :
 	OSCInterface(getTypeString(), true),
-	customParams("Custom Parameters", false, false, false, false)
+	customParams("Custom Parameters", false, false, false, false),
+	changedEntries(var(Array<var>()))
 {
+	batchObjects = addBoolParameter("Batch Objects", "If checked, the script function sendValuesForObjects(objects) is called once per update with all the objects that changed, instead of calling sendValuesForObject for each object", false);
+
 	addChildControllableContainer(&customParams);
 	customParams.addBaseManagerListener(this);
 }
@@ -45,6 +48,22 @@ void CustomOSCInterface::itemsRemoved(Array<GenericControllableItem*>)
 
 void CustomOSCInterface::sendValuesForObjectInternal(Object* o)
 {
+	if (batchObjects->boolValue())
+	{
+		GenericScopedLock lock(batchLock);
+		var entry = batchEntries[o];
+		if (!entry.isObject())
+		{
+			entry = var(new DynamicObject());
+			entry.getDynamicObject()->setProperty("values", new DynamicObject());
+			entry.getDynamicObject()->setProperty("params", new DynamicObject());
+			batchEntries.set(o, entry);
+		}
+
+		if (updateBatchEntry(o, entry)) changedEntries.append(entry);
+		return;
+	}
+
 	var data(new DynamicObject());
 	data.getDynamicObject()->setProperty("values", new DynamicObject()); //needed to fill
 
@@ -63,6 +82,84 @@ void CustomOSCInterface::sendValuesForObjectInternal(Object* o)
 	scriptManager->callFunctionOnAllItems("sendValuesForObject", args);
 }
 
+bool CustomOSCInterface::updateBatchEntry(Object* o, var entry)
+{
+	DynamicObject* entryData = entry.getDynamicObject();
+	DynamicObject* values = entryData->getProperty("values").getDynamicObject();
+
+	entryData->setProperty("object", o->getScriptObject());
+
+	bool changed = false;
+	for (auto& c : o->componentManager->items)
+	{
+		var cData = values->getProperty(c->shortName);
+		if (!c->enabled->boolValue())
+		{
+			if (cData.isObject())
+			{
+				values->removeProperty(c->shortName);
+				changed = true;
+			}
+			continue;
+		}
+
+		if (changed) continue;
+
+		if (!cData.isObject())
+		{
+			changed = true;
+			continue;
+		}
+
+		for (auto& p : c->computedParameters)
+		{
+			if (cData.getProperty(p->shortName, var()) != p->getValue())
+			{
+				changed = true;
+				break;
+			}
+		}
+	}
+
+	if (changed)
+	{
+		for (auto& c : o->componentManager->items) c->fillInterfaceData(this, entry, var());
+	}
+
+	if (((CustomOSCParams*)o->interfaceParameters.get())->updateParamValues(entryData->getProperty("params"))) changed = true;
+
+	return changed;
+}
+
+void CustomOSCInterface::finishSendValues()
+{
+	if (batchObjects->boolValue())
+	{
+		if (changedEntries.size() > 0)
+		{
+			Array<var> args;
+			args.add(changedEntries);
+			scriptManager->callFunctionOnAllItems("sendValuesForObjects", args);
+			changedEntries.getArray()->clearQuick();
+		}
+	}
+	else if (batchEntries.size() > 0)
+	{
+		//cleared from the update thread, so entries are never touched while being filled
+		GenericScopedLock lock(batchLock);
+		batchEntries.clear();
+		changedEntries.getArray()->clear();
+	}
+
+	OSCInterface::finishSendValues(); //after the script calls so their messages are part of this frame's bundles
+}
+
+void CustomOSCInterface::objectRemoved(Object* o)
+{
+	GenericScopedLock lock(batchLock);
+	batchEntries.remove(o);
+}
+
 CustomOSCInterface::CustomOSCParams::CustomOSCParams(CustomOSCInterface* i) :
 	ControllableContainer("Interface Parameters"),
 	itf(i)
@@ -125,3 +222,31 @@ var CustomOSCInterface::CustomOSCParams::getParamValues()
 	}
 	return values;
 }
+
+bool CustomOSCInterface::CustomOSCParams::updateParamValues(var values)
+{
+	DynamicObject* d = values.getDynamicObject();
+	if (d == nullptr) return false;
+
+	bool changed = false;
+	Array<WeakReference<Parameter>> params = getAllParameters();
+	for (auto& p : params)
+	{
+		Parameter* targetP = p;
+		if (!p->enabled)
+		{
+			if (GenericControllableItem* gci = itf->customParams.getItemWithName(p->shortName)) targetP = (Parameter*)gci->controllable;
+			else targetP = nullptr;
+		}
+
+		if (targetP == nullptr) continue;
+
+		var v = targetP->getValue();
+		if (d->hasProperty(targetP->shortName) && d->getProperty(targetP->shortName) == v) continue;
+
+		d->setProperty(targetP->shortName, v);
+		changed = true;
+	}
+
+	return changed;
+}
\ No newline at end of file
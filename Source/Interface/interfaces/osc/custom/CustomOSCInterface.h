@@ -24,9 +24,19 @@ public:
     virtual void itemsRemoved(Array<GenericControllableItem*>) override;
 
     virtual void sendValuesForObjectInternal(Object* o) override;
+    virtual void finishSendValues() override;
+    virtual void objectRemoved(Object* o) override;
 
     GenericControllableManager customParams;
 
+    //batch mode : entries are kept per object and updated in place, changed ones are sent in one call at the end of the frame
+    BoolParameter* batchObjects;
+    HashMap<Object*, var> batchEntries;
+    CriticalSection batchLock; //entries are filled from the update thread and pruned from the message thread
+    var changedEntries;
+
+    bool updateBatchEntry(Object* o, var entry);
+
     //Listener
     class CustomOSCInterfaceListener
     {
@@ -56,6 +66,7 @@ public:
         void rebuildArgsFromInterface();
 
         var getParamValues();
+        bool updateParamValues(var values); //returns true if a value changed
     };
 
     String getTypeString() const override { return "OSC"; }
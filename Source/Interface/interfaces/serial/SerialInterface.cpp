@@ -14,7 +14,8 @@
 SerialInterface::SerialInterface() :
 	Interface("Serial", true),
 	port(nullptr),
-	customParams("Custom Parameters", false, false, false, false)
+	customParams("Custom Parameters", false, false, false, false),
+	packetCC("Packet Template")
 {
 
 	portParam = new SerialDeviceParameter("Port", "Serial Port to connect", true);
@@ -26,6 +27,16 @@ SerialInterface::SerialInterface() :
 	isConnected->isSavable = false;
 	//connectionFeedbackRef = isConnected;
 
+	outputMode = addEnumParameter("Output Mode", "Script calls sendValuesForObject in the scripts for each object. Packet Template writes the bytes described in Packet Template directly, without any script call.");
+	outputMode->addOption("Script", SCRIPT)->addOption("Packet Template", PACKET_TEMPLATE);
+
+	packetHeader = packetCC.addStringParameter("Header", "Bytes written at the start of each object's packet, in hex (e.g. \"FF 01\")", "");
+	packetFields = packetCC.addStringParameter("Fields", "Comma separated fields written for each object. \"Component.Parameter\" writes a 8-bit value (all values for colors and points), \"Component.Parameter[i]\" writes the value at index i, add \":16\" or \":16le\" for 16-bit big or little endian values. \"id\" writes the object's global ID and hex bytes like \"0x00\" are written as is. Normalized values are scaled to the full range, others are written as is.", "Dimmer.Value");
+	packetFooter = packetCC.addStringParameter("Footer", "Bytes written at the end of each object's packet, in hex", "");
+	cobsFraming = packetCC.addBoolParameter("COBS Framing", "If checked, each packet is COBS encoded and followed by a 0 delimiter", false);
+	addChildControllableContainer(&packetCC);
+	compilePacketTemplate();
+
 	scriptObject.getDynamicObject()->setMethod(sendId, SerialInterface::sendStringFromScript);
 	scriptObject.getDynamicObject()->setMethod(sendBytesId, SerialInterface::sendBytesFromScript);
 
@@ -133,8 +144,21 @@ void SerialInterface::onContainerParameterChangedInternal(Parameter* p)
 	}
 }
 
+void SerialInterface::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+	Interface::onControllableFeedbackUpdateInternal(cc, c);
+
+	if (c == packetHeader || c == packetFields || c == packetFooter) compilePacketTemplate();
+}
+
 void SerialInterface::sendValuesForObjectInternal(Object* o)
 {
+	if (outputMode->getValueDataAsEnum<OutputMode>() == PACKET_TEMPLATE)
+	{
+		writePacketForObject(o);
+		return;
+	}
+
 	Array<var> args;
 	args.add(o->getScriptObject());
 
@@ -155,6 +179,226 @@ void SerialInterface::sendValuesForObjectInternal(Object* o)
 	scriptManager->callFunctionOnAllItems("sendValuesForObject", args);
 }
 
+void SerialInterface::objectRemoved(Object* o)
+{
+	GenericScopedLock lock(packetLock);
+	if (ObjectPacketCache* cache = packetCaches[o])
+	{
+		packetCaches.remove(o);
+		packetCachePool.removeObject(cache);
+	}
+}
+
+void SerialInterface::objectComponentsChanged(Object* o)
+{
+	//fields that were not found may now resolve to a new component
+	GenericScopedLock lock(packetLock);
+	if (ObjectPacketCache* cache = packetCaches[o]) cache->isValid = false;
+}
+
+void SerialInterface::compilePacketTemplate()
+{
+	GenericScopedLock lock(packetLock);
+
+	packetHeaderBytes = parseBytes(packetHeader->stringValue());
+	packetFooterBytes = parseBytes(packetFooter->stringValue());
+	compiledFields.clearQuick();
+
+	StringArray fields;
+	fields.addTokens(packetFields->stringValue(), ",", "\"");
+	fields.trim();
+	fields.removeEmptyStrings();
+
+	for (auto& fs : fields)
+	{
+		PacketField f;
+		String def = fs.upToFirstOccurrenceOf(":", false, false).trim();
+		String format = fs.fromFirstOccurrenceOf(":", false, false).trim().toLowerCase();
+		f.is16Bit = format.startsWith("16");
+		f.littleEndian = format == "16le";
+
+		if (def.startsWithIgnoreCase("0x"))
+		{
+			f.type = PacketField::LITERAL;
+			f.literal = (uint8)def.substring(2).getHexValue32();
+		}
+		else if (def.equalsIgnoreCase("id"))
+		{
+			f.type = PacketField::OBJECT_ID;
+		}
+		else
+		{
+			f.type = PacketField::VALUE;
+			f.componentName = def.upToFirstOccurrenceOf(".", false, false).trim();
+			String paramDef = def.fromFirstOccurrenceOf(".", false, false).trim();
+			f.paramName = paramDef.upToFirstOccurrenceOf("[", false, false).trim();
+			if (paramDef.contains("[")) f.valueIndex = paramDef.fromFirstOccurrenceOf("[", false, false).getIntValue();
+
+			if (f.componentName.isEmpty() || f.paramName.isEmpty())
+			{
+				NLOGWARNING(niceName, "Invalid packet field : " << fs);
+				continue;
+			}
+		}
+
+		compiledFields.add(f);
+	}
+
+	//resolved parameters depend on the fields
+	for (auto& c : packetCachePool) c->isValid = false;
+}
+
+Array<uint8> SerialInterface::parseBytes(const String& s)
+{
+	Array<uint8> result;
+	StringArray tokens;
+	tokens.addTokens(s, " ,", "");
+	tokens.removeEmptyStrings();
+	for (auto& t : tokens) result.add((uint8)t.getHexValue32());
+	return result;
+}
+
+SerialInterface::ObjectPacketCache* SerialInterface::getPacketCache(Object* o)
+{
+	ObjectPacketCache* cache = packetCaches[o];
+	if (cache == nullptr)
+	{
+		cache = packetCachePool.add(new ObjectPacketCache());
+		packetCaches.set(o, cache);
+	}
+
+	if (cache->isValid)
+	{
+		//a component or parameter could have been removed since the fields were resolved
+		for (int i = 0; i < compiledFields.size(); i++)
+		{
+			if (compiledFields[i].type == PacketField::VALUE && cache->params[i].wasObjectDeleted())
+			{
+				cache->isValid = false;
+				break;
+			}
+		}
+	}
+
+	if (!cache->isValid)
+	{
+		cache->params.clearQuick();
+		for (auto& f : compiledFields)
+		{
+			Parameter* target = nullptr;
+			if (f.type == PacketField::VALUE)
+			{
+				for (auto& c : o->componentManager->items)
+				{
+					if (c->niceName != f.componentName && c->shortName != f.componentName) continue;
+					for (auto& p : c->computedParameters)
+					{
+						if (p->niceName == f.paramName || p->shortName == f.paramName)
+						{
+							target = p;
+							break;
+						}
+					}
+					break;
+				}
+			}
+			cache->params.add(target);
+		}
+		cache->isValid = true;
+	}
+
+	return cache;
+}
+
+void SerialInterface::writePacketValue(const PacketField& f, float v, bool scale)
+{
+	if (f.is16Bit)
+	{
+		uint16 val = (uint16)jlimit<int>(0, 65535, scale ? roundToInt(v * 65535) : roundToInt(v));
+		uint8 hi = (uint8)(val >> 8);
+		uint8 lo = (uint8)(val & 0xFF);
+		packetBuffer.add(f.littleEndian ? lo : hi);
+		packetBuffer.add(f.littleEndian ? hi : lo);
+	}
+	else
+	{
+		packetBuffer.add((uint8)jlimit<int>(0, 255, scale ? roundToInt(v * 255) : roundToInt(v)));
+	}
+}
+
+void SerialInterface::writePacketForObject(Object* o)
+{
+	if (port == nullptr) return;
+
+	GenericScopedLock lock(packetLock);
+
+	ObjectPacketCache* cache = getPacketCache(o);
+
+	packetBuffer.clearQuick();
+	packetBuffer.addArray(packetHeaderBytes);
+
+	for (int i = 0; i < compiledFields.size(); i++)
+	{
+		const PacketField& f = compiledFields.getReference(i);
+		switch (f.type)
+		{
+		case PacketField::LITERAL:
+			packetBuffer.add(f.literal);
+			break;
+
+		case PacketField::OBJECT_ID:
+			writePacketValue(f, o->globalID->intValue(), false);
+			break;
+
+		case PacketField::VALUE:
+		{
+			Parameter* p = cache->params[i];
+			if (p == nullptr)
+			{
+				writePacketValue(f, 0, false); //keep the packet size when the parameter is not found
+				break;
+			}
+
+			if (p->value.isArray())
+			{
+				bool scale = p->type == Controllable::COLOR;
+				if (f.valueIndex >= 0) writePacketValue(f, f.valueIndex < p->value.size() ? (float)p->value[f.valueIndex] : 0, scale); //out of range indices write 0 to keep the packet size
+				else
+				{
+					int numValues = p->type == Controllable::COLOR ? jmin(3, p->value.size()) : p->value.size(); //colors are written as RGB
+					for (int j = 0; j < numValues; j++) writePacketValue(f, p->value[j], scale);
+				}
+			}
+			else if (p->type == Controllable::FLOAT && p->hasRange())
+			{
+				writePacketValue(f, p->getNormalizedValue(), true);
+			}
+			else
+			{
+				writePacketValue(f, p->value, false);
+			}
+		}
+		break;
+		}
+	}
+
+	packetBuffer.addArray(packetFooterBytes);
+
+	if (cobsFraming->boolValue())
+	{
+		//COBS adds at most one byte every 254 bytes, plus the delimiter
+		cobsBuffer.resize(packetBuffer.size() + packetBuffer.size() / 254 + 2);
+		size_t encodedSize = cobs_encode(packetBuffer.getRawDataPointer(), packetBuffer.size(), cobsBuffer.getRawDataPointer());
+		cobsBuffer.set((int)encodedSize, 0);
+		cobsBuffer.resize((int)encodedSize + 1);
+		sendBytes(cobsBuffer);
+	}
+	else
+	{
+		sendBytes(packetBuffer);
+	}
+}
+
 void SerialInterface::serialDataReceived(SerialDevice*, const var& data)
 {
 	if (logIncomingData->boolValue())
@@ -172,7 +416,7 @@ void SerialInterface::sendMessage(const String& message, var)
 	port->writeString(message);
 }
 
-void SerialInterface::sendBytes(Array<uint8> data, var)
+void SerialInterface::sendBytes(const Array<uint8>& data, var)
 {
 	if (port == nullptr) return;
 
@@ -30,6 +30,48 @@ public:
 
     GenericControllableManager customParams;
 
+    //Packet template mode : values are written natively by a compiled list of fields, without calling the scripts
+    enum OutputMode { SCRIPT, PACKET_TEMPLATE };
+    EnumParameter* outputMode;
+    ControllableContainer packetCC;
+    StringParameter* packetHeader;
+    StringParameter* packetFields;
+    StringParameter* packetFooter;
+    BoolParameter* cobsFraming;
+
+    struct PacketField
+    {
+        enum Type { LITERAL, OBJECT_ID, VALUE };
+        Type type = LITERAL;
+        uint8 literal = 0;
+        String componentName;
+        String paramName;
+        int valueIndex = -1; //for arrays (colors, points), -1 writes all the values
+        bool is16Bit = false;
+        bool littleEndian = false;
+    };
+
+    struct ObjectPacketCache
+    {
+        Array<WeakReference<Parameter>> params; //one per field, null for fields without value or not found on the object
+        bool isValid = false;
+    };
+
+    CriticalSection packetLock;
+    Array<PacketField> compiledFields;
+    Array<uint8> packetHeaderBytes;
+    Array<uint8> packetFooterBytes;
+    HashMap<Object*, ObjectPacketCache*> packetCaches;
+    OwnedArray<ObjectPacketCache> packetCachePool;
+    Array<uint8> packetBuffer;
+    Array<uint8> cobsBuffer;
+
+    void compilePacketTemplate();
+    static Array<uint8> parseBytes(const String& s);
+    ObjectPacketCache* getPacketCache(Object* o);
+    void writePacketForObject(Object* o);
+    void writePacketValue(const PacketField& f, float v, bool scale);
+
     const Identifier sendId = "send";
     const Identifier sendBytesId = "sendBytes";
 
@@ -37,13 +79,16 @@ public:
 	virtual bool setPortStatus(bool status);
 
 	virtual void onContainerParameterChangedInternal(Parameter* p) override;
+	virtual void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
 	virtual void sendValuesForObjectInternal(Object* o) override;
+	virtual void objectRemoved(Object* o) override;
+	virtual void objectComponentsChanged(Object* o) override;
 
     void serialDataReceived(SerialDevice*, const var&) override;
 
     virtual void sendMessage(const String& message, var params = var());
-    virtual void sendBytes(Array<uint8> bytes, var params = var());
+    virtual void sendBytes(const Array<uint8>& bytes, var params = var());
 
     static var sendStringFromScript(const var::NativeFunctionArgs& a);
     static var sendBytesFromScript(const var::NativeFunctionArgs& a);
@@ -3,14 +3,22 @@
 
 BluxApplication::BluxApplication() : 
     OrganicApplication(ProjectInfo::projectName, 
-        true, 
+        !BluxBenchmark::isRequested(), 
         BluxAssetManager::getImage("icon3"))
 {
 }
 
-void BluxApplication::initialiseInternal(const String&)
+void BluxApplication::initialiseInternal(const String& commandLine)
 {
     engine.reset(new BluxEngine());
+
+	if (BluxBenchmark::isRequested())
+	{
+		benchmark.reset(new BluxBenchmark(commandLine));
+		benchmark->launch();
+		return;
+	}
+
 	mainComponent.reset(new MainComponent());
 
 
@@ -11,6 +11,8 @@
 #pragma once
 
 #include "JuceHeader.h"
+
+class BluxBenchmark;
 /*
   ==============================================================================
 
@@ -27,6 +29,8 @@ public:
     BluxApplication();
 
     void initialiseInternal(const String &commandLine) override;
+
+    std::unique_ptr<BluxBenchmark> benchmark;
 };
 
 //==============================================================================
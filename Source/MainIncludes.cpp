@@ -25,4 +25,5 @@
 #include "UI/AssetManager.cpp"
 #include "UI/BluxInspector.cpp"
 #include "Engine/BluxEngine.cpp"
+#include "Engine/BluxBenchmark.cpp"
 #include "Engine/GenericAction.cpp"
\ No newline at end of file
@@ -21,4 +21,5 @@
 #include "UI/BluxInspector.h"
 
 #include "Engine/BluxEngine.h"
+#include "Engine/BluxBenchmark.h"
 #include "Engine/GenericAction.h"
\ No newline at end of file
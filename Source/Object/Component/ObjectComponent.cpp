@@ -11,12 +11,21 @@
 #include "Object/ObjectIncludes.h"
 #include "Interface/InterfaceIncludes.h"
 
+CriticalSection ObjectComponent::stateIndexLock;
+Array<int> ObjectComponent::freeStateIndices;
+int ObjectComponent::numStateIndices = 0;
+
 ObjectComponent::ObjectComponent(Object* o, String name, ComponentType componentType, var params) :
 	BaseItem(name, true),
 	object(o),
 	componentType(componentType),
 	mainParameter(nullptr),
-	interfaceParamCC("Interface Params")
+	stateIndex(acquireStateIndex()),
+	interfaceParamCC("Interface Params"),
+	numComputedSlots(0),
+	computedSlotsDirty(true),
+	computedSlotsAreCurrent(false),
+	computedValuesAreCurrent(true)
 {
 	saveAndLoadRecursiveData = true;
 
@@ -26,11 +35,27 @@ ObjectComponent::ObjectComponent(Object* o, String name, ComponentType component
 	canBeReorderedInEditor = true;
 
 	interfaceParamCC.hideInEditor = interfaceParams.isEmpty();
+	interfaceParamCC.saveAndLoadRecursiveData = true; //custom response curves
 	addChildControllableContainer(&interfaceParamCC);
 }
 
 ObjectComponent::~ObjectComponent()
 {
+	FilterManager::invalidateAllCaches();
+	releaseStateIndex(stateIndex);
+}
+
+int ObjectComponent::acquireStateIndex()
+{
+	GenericScopedLock lock(stateIndexLock);
+	if (!freeStateIndices.isEmpty()) return freeStateIndices.removeAndReturn(freeStateIndices.size() - 1);
+	return numStateIndices++;
+}
+
+void ObjectComponent::releaseStateIndex(int index)
+{
+	GenericScopedLock lock(stateIndexLock);
+	freeStateIndices.add(index);
 }
 
 void ObjectComponent::rebuildInterfaceParams(Interface* interface)
@@ -41,6 +66,10 @@ void ObjectComponent::rebuildInterfaceParams(Interface* interface)
 	interfaceParamCC.clear();
 	interfaceParams.clear();
 	computedInterfaceMap.clear();
+	responseCurveMap.clear();
+	setResponseTables(nullptr); //tables used by the custom curves are kept alive by the retired set
+	customResponseMap.clear();
+	customResponses.clear();
 
 	if (interface == nullptr) return;
 
@@ -59,15 +88,135 @@ void ObjectComponent::rebuildInterfaceParams(Interface* interface)
 			interfaceParams.add(p);
 			computedInterfaceMap.set(cp, p);
 			i += p->value.size();
+
+			if (canUseResponseCurve(cp))
+			{
+				EnumParameter* rp = interfaceParamCC.addEnumParameter(cp->niceName + " Response", "Response curve applied to this channel when sending");
+				rp->addOption("Linear", LINEAR)->addOption("Square Law", SQUARE_LAW)->addOption("S-Curve", S_CURVE)->addOption("Custom", CUSTOM);
+				responseCurveMap.set(cp, rp);
+			}
 		}
 	}
 
 	interfaceParamCC.loadJSONData(oldData);
 	interfaceParamCC.hideInEditor = interfaceParams.isEmpty();
+	updateResponseTables();
 
 	interfaceParamsGhostData = var();
 }
 
+void ObjectComponent::updateResponseTables()
+{
+	ResponseTableSet* set = new ResponseTableSet();
+	for (auto& cp : computedParameters)
+	{
+		ResponseTable* table = nullptr;
+		if (EnumParameter* rp = responseCurveMap[cp])
+		{
+			ResponseCurve curve = rp->getValueDataAsEnum<ResponseCurve>();
+			CustomResponse* custom = customResponseMap[cp];
+
+			if (curve == CUSTOM && custom == nullptr)
+			{
+				//added while loading too, before the child containers are loaded, so saved curves are restored
+				custom = customResponses.add(new CustomResponse(cp->niceName + " Response Curve"));
+				interfaceParamCC.addChildControllableContainer(&custom->automation);
+				customResponseMap.set(cp, custom);
+			}
+
+			if (custom != nullptr) custom->automation.hideInEditor = curve != CUSTOM;
+
+			if (curve == CUSTOM) table = set->usedTables.add(custom->bake());
+			else if (curve != LINEAR) table = set->usedTables.add(getBakedResponseTable(curve));
+		}
+
+		set->entries.add({ cp, table != nullptr ? table->values.get() : nullptr });
+	}
+
+	setResponseTables(set);
+}
+
+void ObjectComponent::setResponseTables(ResponseTableSet* set)
+{
+	ObjectManager* om = ObjectManager::getInstanceWithoutCreating();
+
+	//sets retired before the current frame started can't be read anymore
+	for (int i = responseTableSets.size() - 1; i >= 0; i--)
+	{
+		ResponseTableSet* s = responseTableSets.getUnchecked(i);
+		if (s != responseTables.get() && (om == nullptr || s->retiredFrame != om->frameCount.get())) responseTableSets.remove(i);
+	}
+
+	ResponseTableSet* oldSet = responseTables.get();
+	if (set != nullptr) responseTableSets.add(set);
+	responseTables = set;
+
+	//tagged after the swap, so a frame that could still read the old set is not mistaken for an earlier one
+	if (oldSet != nullptr) oldSet->retiredFrame = om != nullptr ? om->frameCount.get() : 0;
+}
+
+const uint16* ObjectComponent::getResponseTable(int channelIndex, Parameter* computedP) const
+{
+	ResponseTableSet* set = responseTables.get();
+	if (set == nullptr || channelIndex < 0 || channelIndex >= set->entries.size()) return nullptr;
+
+	const ResponseTableSet::Entry& e = set->entries.getReference(channelIndex);
+	return e.computedParam == computedP ? e.table : nullptr; //channels may have changed since the set was built
+}
+
+ObjectComponent::CustomResponse::CustomResponse(const String& name) :
+	automation(name)
+{
+	AutomationKey* k = automation.addKey(0, 0);
+	k->easingType->setValueWithData(Easing::LINEAR);
+	automation.addKey(1, 1);
+}
+
+ObjectComponent::ResponseTable::Ptr ObjectComponent::CustomResponse::bake()
+{
+	ResponseTable::Ptr table = new ResponseTable();
+
+	//rebaked each time a key moves, so the curve is sampled coarsely and interpolated
+	const int numSamples = 1024;
+	float samples[numSamples + 1];
+	for (int i = 0; i <= numSamples; i++) samples[i] = jlimit(0.f, 1.f, (float)automation.getValueAtPosition(i / (float)numSamples));
+
+	for (int i = 0; i < RESPONSE_TABLE_SIZE; i++)
+	{
+		float pos = i * numSamples / (float)(RESPONSE_TABLE_SIZE - 1);
+		int index = jmin((int)pos, numSamples - 1);
+		table->values[i] = (uint16)roundToInt(jmap(pos - index, samples[index], samples[index + 1]) * 65535);
+	}
+
+	return table;
+}
+
+ObjectComponent::ResponseTable* ObjectComponent::getBakedResponseTable(ResponseCurve curve)
+{
+	static ResponseTable::Ptr tables[RESPONSE_CURVES_MAX];
+	static SpinLock tablesLock;
+
+	GenericScopedLock lock(tablesLock);
+	if (tables[curve] == nullptr)
+	{
+		tables[curve] = new ResponseTable();
+		for (int i = 0; i < RESPONSE_TABLE_SIZE; i++)
+		{
+			float v = i / (float)(RESPONSE_TABLE_SIZE - 1);
+			switch (curve)
+			{
+			case SQUARE_LAW: v = v * v; break;
+			case S_CURVE: v = v * v * (3 - 2 * v); break;
+			default: break;
+			}
+
+			tables[curve]->values[i] = (uint16)roundToInt(v * 65535);
+		}
+	}
+
+	return tables[curve].get();
+}
+
 Parameter* ObjectComponent::addComputedParameter(Parameter* p, ControllableContainer* parent, bool addToSceneParams)
 {
 	if (parent == nullptr) parent = this;
@@ -86,6 +235,7 @@ Parameter* ObjectComponent::addComputedParameter(Parameter* p, ControllableConta
 	if (addToSceneParams) sceneDataParameters.addIfNotAlreadyThere(p);
 
 	if (computedParameters.size() == 1) mainParameter = cp;
+	computedSlotsDirty = true;
 
 	return p;
 }
@@ -107,6 +257,7 @@ void ObjectComponent::removeComputedParameter(Parameter* p)
 	}
 
 	computedParamMap.remove(p);
+	computedSlotsDirty = true;
 	p->parentContainer->removeControllable(p);
 }
 
@@ -118,22 +269,45 @@ void ObjectComponent::onContainerParameterChangedInternal(Parameter* p)
 
 }
 
+void ObjectComponent::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+	BaseItem::onControllableFeedbackUpdateInternal(cc, c);
+
+	//response enums are in interfaceParamCC, custom curve keys are deeper in it
+	for (ControllableContainer* p = cc; p != nullptr && p != this; p = p->parentContainer)
+	{
+		if (p != &interfaceParamCC) continue;
+		updateResponseTables();
+		break;
+	}
+}
+
 void ObjectComponent::fillComputedValueMap(HashMap<Parameter*, var>& values)
 {
+	if (computedSlotsDirty) rebuildComputedSlots();
+
 	for (auto& c : computedParameters)
 	{
 		if (computedParamMap.contains(c))
 		{
 			//DBG("Set computed value to source value " << computedParamMap[c]->niceName << " : " << computedParamMap[c]->floatValue());
-			values.set(c, computedParamMap[c]->getValue().clone());
+			Parameter* sourceP = computedParamMap[c];
+			if (const ComputedSlot* s = getComputedSlot(c)) readSlotValue(*s, sourceP->getValue(), computedSlots.getRawDataPointer() + s->offset);
+			else values.set(c, sourceP->getValue().clone());
 		}
 	}
+
+	computedSlotsAreCurrent = true;
+	computedValuesAreCurrent = false;
 }
 
 void ObjectComponent::updateComputedValues(HashMap<Parameter*, var>& values)
 {
 	if (ObjectManager::getInstance()->blackOut->boolValue())
 	{
+		syncComputedValuesFromSlots();
+		invalidateComputedSlots();
+
 		for (auto& p : computedParameters)
 		{
 			if (values[p].isArray())
@@ -163,7 +337,150 @@ void ObjectComponent::updateComputedValues(HashMap<Parameter*, var>& values)
 	for (auto& p : computedParameters)
 	{
 		//DBG("update computed value after chain, " << p->niceName << " : " << values[p].toString());
-		p->setValue(values[p]);
+		const ComputedSlot* s = computedSlotsAreCurrent ? getComputedSlot(p) : nullptr;
+		if (s == nullptr) p->setValue(values[p]);
+		else if (s->numItems == 0) p->setValue(computedSlots[s->offset]);
+		else
+		{
+			var v;
+			writeSlotValue(*s, computedSlots.getRawDataPointer() + s->offset, v);
+			p->setValue(v);
+		}
+	}
+}
+
+void ObjectComponent::rebuildComputedSlots()
+{
+	computedSlotLayout.clearQuick();
+	fillComputedSlotLayout(computedSlotLayout);
+
+	computedSlotIndices.clear();
+	int offset = 0;
+	for (int i = 0; i < computedSlotLayout.size(); i++)
+	{
+		ComputedSlot& s = computedSlotLayout.getReference(i);
+		s.offset = offset;
+		offset += s.getSize();
+		computedSlotIndices.set(s.key, i);
+	}
+
+	numComputedSlots = offset;
+	computedSlots.resize(numComputedSlots);
+	computedSlotsDirty = false;
+	computedSlotsAreCurrent = false;
+	computedValuesAreCurrent = true;
+}
+
+void ObjectComponent::fillComputedSlotLayout(Array<ComputedSlot>& layout)
+{
+	for (auto& c : computedParameters)
+	{
+		if (!computedParamMap.contains(c)) continue;
+
+		int numItems = -1;
+		switch (c->type)
+		{
+		case Controllable::FLOAT: numItems = 0; break;
+		case Controllable::POINT2D: numItems = 2; break;
+		case Controllable::POINT3D: numItems = 3; break;
+		case Controllable::COLOR: numItems = 4; break;
+		default: break; //other types stay in the table only
+		}
+
+		if (numItems >= 0) layout.add(ComputedSlot{ c, 0, numItems, 0 });
+	}
+}
+
+const ObjectComponent::ComputedSlot* ObjectComponent::getComputedSlot(Parameter* key) const
+{
+	if (!computedSlotIndices.contains(key)) return nullptr;
+	return &computedSlotLayout.getReference(computedSlotIndices[key]);
+}
+
+float* ObjectComponent::getComputedSlotValues(Parameter* key)
+{
+	const ComputedSlot* s = getComputedSlot(key);
+	return s != nullptr ? computedSlots.getRawDataPointer() + s->offset : nullptr;
+}
+
+void ObjectComponent::syncComputedValuesFromSlots()
+{
+	if (computedValuesAreCurrent) return;
+
+	const float* slotValues = computedSlots.getRawDataPointer();
+	for (auto& s : computedSlotLayout) writeSlotValue(s, slotValues + s.offset, computedValues.getReference(s.key));
+	computedValuesAreCurrent = true;
+}
+
+void ObjectComponent::syncComputedSlotsFromValues()
+{
+	if (computedSlotsAreCurrent) return;
+
+	float* slotValues = computedSlots.getRawDataPointer();
+	for (auto& s : computedSlotLayout)
+	{
+		if (computedValues.contains(s.key)) readSlotValue(s, computedValues.getReference(s.key), slotValues + s.offset);
+	}
+	computedSlotsAreCurrent = true;
+}
+
+void ObjectComponent::readSlotValue(const ComputedSlot& s, const var& value, float* slotValues)
+{
+	if (s.numItems == 0)
+	{
+		slotValues[0] = value;
+		return;
+	}
+
+	//missing elements are read as 0, like an unset parameter
+	const Array<var>* items = value.getArray();
+	for (int i = 0; i < s.numItems; i++)
+	{
+		const var* item = items != nullptr && i < items->size() ? &items->getReference(i) : nullptr;
+		if (s.itemSize == 0)
+		{
+			slotValues[i] = item != nullptr ? (float)*item : 0;
+			continue;
+		}
+
+		const Array<var>* itemValues = item != nullptr ? item->getArray() : nullptr;
+		for (int j = 0; j < s.itemSize; j++) slotValues[i * s.itemSize + j] = itemValues != nullptr && j < itemValues->size() ? (float)itemValues->getReference(j) : 0;
+	}
+}
+
+void ObjectComponent::writeSlotValue(const ComputedSlot& s, const float* slotValues, var& value)
+{
+	if (s.numItems == 0)
+	{
+		value = slotValues[0];
+		return;
+	}
+
+	//arrays are only reallocated when their shape changes, otherwise elements are assigned in place
+	if (!value.isArray() || value.size() != s.numItems)
+	{
+		value = var(Array<var>());
+		value.getArray()->resize(s.numItems);
+	}
+
+	Array<var>* items = value.getArray();
+	for (int i = 0; i < s.numItems; i++)
+	{
+		var& item = items->getReference(i);
+		if (s.itemSize == 0)
+		{
+			item = slotValues[i];
+			continue;
+		}
+
+		if (!item.isArray() || item.size() != s.itemSize)
+		{
+			item = var(Array<var>());
+			item.getArray()->resize(s.itemSize);
+		}
+
+		Array<var>* values = item.getArray();
+		for (int j = 0; j < s.itemSize; j++) values->getReference(j) = slotValues[i * s.itemSize + j];
 	}
 }
 
@@ -230,43 +547,68 @@ void ObjectComponent::fillInterfaceData(Interface* i, var data, var params)
 
 void ObjectComponent::fillInterfaceDataInternal(Interface* i, var data, var params)
 {
-	//depending on interface, change what's happening here.
+	//depending on interface, change what's happening here. DMX interfaces use the raw channels version below
+
+	DynamicObject* valData = data.getProperty("values", var()).getDynamicObject();
+	if (valData == nullptr) return;
+
+	//reuse the component object if the data is kept between frames
+	var cData = valData->getProperty(shortName);
+	if (!cData.isObject())
+	{
+		cData = var(new DynamicObject());
+		valData->setProperty(shortName, cData);
+	}
+
+	for (auto& p : computedParameters) cData.getDynamicObject()->setProperty(p->shortName, p->getValue());
+}
+
+void ObjectComponent::fillInterfaceData(DMXInterface* di, uint8* channels, int channelOffset)
+{
+	if (di == nullptr) return;
+	if (!enabled->boolValue()) return;
 
+	fillInterfaceDataInternal(di, channels, channelOffset);
+}
+
+void ObjectComponent::fillInterfaceDataInternal(DMXInterface* di, uint8* channels, int channelOffset)
+{
 	bool blackout = ObjectManager::getInstance()->blackOut->boolValue();
 
-	if (DMXInterface* di = dynamic_cast<DMXInterface*>(i))
+	for (int index = 0; index < computedParameters.size(); index++)
 	{
-		int channelOffset = params.getProperty("channelOffset", 0);
-		var channelsData = data.getProperty("channels", var());
+		Parameter* cp = computedParameters[index];
+		Parameter* channelP = computedInterfaceMap[cp];
+		if (channelP == nullptr || !channelP->enabled) continue;
+		int channel = channelP->intValue();
+		int targetChannel = channelOffset + channel - 1; //convert local channel to 0-based
 
-		for (auto& cp : computedParameters)
+		if (cp->isComplex())
 		{
-			Parameter* channelP = computedInterfaceMap[cp];
-			if (channelP == nullptr || !channelP->enabled) continue;
-			int channel = channelP->intValue();
-			int targetChannel = channelOffset + channel - 1; //convert local channel to 0-based
-
-			var mappedVal = getMappedValueForComputedParam(i, cp);
-			if (cp->isComplex())
-			{
-				var val = cp->getValue();
-				for (int i = 0; i < val.size(); i++) channelsData[targetChannel + i] = blackout ? 0.f : (float)mappedVal[i];
-			}
-			else
+			if (blackout)
 			{
-				channelsData[targetChannel] = blackout ? 0.f : (float)mappedVal;
+				for (int i = 0; i < cp->value.size(); i++) setDMXChannelValue(channels, targetChannel + i, 0);
+				continue;
 			}
+
+			var mappedVal = getMappedValueForComputedParam(di, cp);
+			for (int i = 0; i < mappedVal.size(); i++) setDMXChannelValue(channels, targetChannel + i, mappedVal[i]);
+		}
+		else if (const uint16* table = getResponseTable(index, cp))
+		{
+			setDMXChannelValue(channels, targetChannel, blackout ? 0 : getResponseValue(table, cp->floatValue()) >> 8);
+		}
+		else
+		{
+			setDMXChannelValue(channels, targetChannel, blackout ? 0.f : (float)getMappedValueForComputedParam(di, cp));
 		}
 	}
-	else
-	{
-		DynamicObject* valData = data.getProperty("values", var()).getDynamicObject();
-		if (valData == nullptr) return;
+}
 
-		var cData(new DynamicObject());
-		for (auto& p : computedParameters) cData.getDynamicObject()->setProperty(p->shortName, p->getValue());
-		valData->setProperty(shortName, cData);
-	}
+void ObjectComponent::setDMXChannelValue(uint8* channels, int channel, float value)
+{
+	if (channel < 0 || channel >= DMX_NUM_CHANNELS) return;
+	channels[channel] = (uint8)jlimit<int>(0, 255, (int)value);
 }
 
 //void ObjectComponent::fillOutValueMap(HashMap<int, float>& channelValueMap, int startChannel, bool ignoreChannelOffset)
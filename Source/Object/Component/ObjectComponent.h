@@ -12,6 +12,7 @@
 
 class Object;
 class Interface;
+class DMXInterface;
 
 class ObjectComponent :
     public BaseItem
@@ -25,6 +26,17 @@ public:
 
     Parameter* mainParameter;
 
+    //Dense index, stable for the life of the component, so effects can keep per component state in arrays instead of maps.
+    //Indices of destroyed components are reused, state owners should check the component they stored
+    int stateIndex;
+
+    static CriticalSection stateIndexLock;
+    static Array<int> freeStateIndices;
+    static int numStateIndices;
+
+    static int acquireStateIndex();
+    static void releaseStateIndex(int index);
+
     ComponentType componentType;
     BoolParameter* excludeFromScenes;
 
@@ -41,15 +53,107 @@ public:
 
     Array<WeakReference<Parameter>> sceneDataParameters;
 
+    HashMap<Parameter*, var> computedValues; //kept between frames to avoid reallocating the table, filled by the compute chain then applied
+
+    //Float, color and point values of the chain are also laid out in a flat float buffer, so effects that support it blend them without building vars.
+    //Both sides are kept lazily in sync : whoever needs the table or the slots syncs them first, and marks the other side stale after writing
+    struct ComputedSlot
+    {
+        Parameter* key; //same key as in computedValues, nullptr for values not linked to a computed parameter
+        int offset;
+        int numItems; //0 for single values
+        int itemSize; //0 when items are single values
+
+        int getSize() const { return jmax(numItems, 1) * jmax(itemSize, 1); }
+    };
+
+    Array<ComputedSlot> computedSlotLayout;
+    HashMap<Parameter*, int> computedSlotIndices;
+    Array<float> computedSlots;
+    int numComputedSlots;
+    bool computedSlotsDirty; //layout needs to be rebuilt before next fill
+    bool computedSlotsAreCurrent;
+    bool computedValuesAreCurrent;
+
+    void rebuildComputedSlots();
+    virtual void fillComputedSlotLayout(Array<ComputedSlot>& layout);
+    const ComputedSlot* getComputedSlot(Parameter* key) const;
+    float* getComputedSlotValues(Parameter* key);
+
+    void syncComputedValuesFromSlots();
+    void syncComputedSlotsFromValues();
+    void invalidateComputedSlots() { computedSlotsAreCurrent = false; }
+    void invalidateComputedValues() { computedValuesAreCurrent = false; }
+    bool hasComputedValues() const { return computedValues.size() > 0 || numComputedSlots > 0; }
+
+    static void readSlotValue(const ComputedSlot& s, const var& value, float* slotValues);
+    static void writeSlotValue(const ComputedSlot& s, const float* slotValues, var& value);
+
+    //Response curves for single float channels, baked into shared 16-bit tables when configured so sending only does a lookup.
+    //8-bit channels use the high byte of the table, fine channels use both bytes
+    enum ResponseCurve { LINEAR, SQUARE_LAW, S_CURVE, CUSTOM, RESPONSE_CURVES_MAX };
+    static const int RESPONSE_TABLE_SIZE = 65536;
+
+    class ResponseTable :
+        public ReferenceCountedObject
+    {
+    public:
+        ResponseTable() { values.allocate(RESPONSE_TABLE_SIZE, false); }
+        HeapBlock<uint16> values;
+
+        typedef ReferenceCountedObjectPtr<ResponseTable> Ptr;
+    };
+
+    //Custom curves are only created for channels set to Custom, each bake makes a new table
+    struct CustomResponse
+    {
+        CustomResponse(const String& name);
+
+        Automation automation;
+
+        ResponseTable::Ptr bake();
+    };
+
+    //Tables of all channels, resolved when a curve changes and indexed like computedParameters, so sending needs no lookup or lock.
+    //A changed set is replaced as a whole, and the replaced one is kept until the next frame since the sending thread may still read it
+    struct ResponseTableSet :
+        public ReferenceCountedObject
+    {
+        struct Entry
+        {
+            Parameter* computedParam;
+            const uint16* table; //null for linear channels
+        };
+
+        Array<Entry> entries;
+        ReferenceCountedArray<ResponseTable> usedTables;
+        uint32 retiredFrame = 0;
+    };
+
+    HashMap<Parameter*, EnumParameter*> responseCurveMap;
+    OwnedArray<CustomResponse> customResponses;
+    HashMap<Parameter*, CustomResponse*> customResponseMap;
+    Atomic<ResponseTableSet*> responseTables;
+    ReferenceCountedArray<ResponseTableSet> responseTableSets; //current and retired sets
+
     void rebuildInterfaceParams(Interface* i);
     virtual bool checkDefaultInterfaceParamEnabled(Parameter* p) { return true; }
+    virtual bool canUseResponseCurve(Parameter* p) { return p->type == Controllable::FLOAT; }
+
+    void updateResponseTables();
+    void setResponseTables(ResponseTableSet* set);
+    const uint16* getResponseTable(int channelIndex, Parameter* computedP) const;
+    static ResponseTable* getBakedResponseTable(ResponseCurve curve);
+    static uint16 getResponseValue(const uint16* table, float value) { return table[jlimit<int>(0, RESPONSE_TABLE_SIZE - 1, roundToInt(value * (RESPONSE_TABLE_SIZE - 1)))]; }
 
     Parameter* addComputedParameter(Parameter* p, ControllableContainer* parent = nullptr, bool addToSceneParams = true);
     void removeComputedParameter(Parameter* p);
 
     void onContainerParameterChangedInternal(Parameter* p) override;
+    void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
     virtual void update() {}
+    virtual bool isTimeDependent() { return false; }
 
     virtual void fillComputedValueMap(HashMap<Parameter*, var>& values);
     virtual void updateComputedValues(HashMap<Parameter*, var>& values);
@@ -66,6 +170,11 @@ public:
     virtual void fillInterfaceDataInternal(Interface* i, var data, var params);// (HashMap<int, float>& channelValueMap, int startChannel, bool ignoreChannelOffset = false);
     //virtual void fillOutValueMap(HashMap<int, float> &channelValueMap, int startChannel, bool ignoreChannelOffset = false);
 
+    //dmx, mapped values are written directly in the universe channels. channelOffset is 0-based
+    virtual void fillInterfaceData(DMXInterface* di, uint8* channels, int channelOffset);
+    virtual void fillInterfaceDataInternal(DMXInterface* di, uint8* channels, int channelOffset);
+    static void setDMXChannelValue(uint8* channels, int channel, float value);
+
     virtual var getMappedValueForComputedParam(Interface* i, Parameter* computedP);
 
     var getJSONData() override;
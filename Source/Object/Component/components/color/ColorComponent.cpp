@@ -13,6 +13,21 @@
 
 bool ColorComponent::isChangingMainColor = false;
 
+//Converted channel values for all pixels, CONVERTED_STRIDE floats per pixel
+static const int CONVERTED_STRIDE = 5;
+
+static float* getConvertedValues(int size)
+{
+	thread_local HeapBlock<float> values;
+	thread_local int valuesSize = 0;
+	if (valuesSize < size)
+	{
+		values.allocate(size, false);
+		valuesSize = size;
+	}
+	return values.get();
+}
+
 ColorComponent::ColorComponent(Object* o, var params) :
 	ObjectComponent(o, getTypeString(), COLOR, params),
 	dimmerComponent(nullptr),
@@ -112,38 +127,48 @@ void ColorComponent::update()
 	else sourceColors.fill(Colours::transparentBlack);
 }
 
+bool ColorComponent::isTimeDependent()
+{
+	return colorSource != nullptr && colorSource->isTimeDependent();
+}
+
+void ColorComponent::fillComputedSlotLayout(Array<ComputedSlot>& layout)
+{
+	layout.add(ComputedSlot{ nullptr, 0, sourceColors.size(), 4 }); //using nullptr as placeholders for values not linked to a computed parameter
+}
+
 void ColorComponent::fillComputedValueMap(HashMap<Parameter*, var>& values)
 {
-	var colors;
-	for (auto& i : sourceColors)
+	if (computedSlotsDirty || numComputedSlots != sourceColors.size() * 4) rebuildComputedSlots();
+
+	//pixels only live in the slots until an effect needs them in the table
+	float* pixels = computedSlots.getRawDataPointer();
+	for (int i = 0; i < sourceColors.size(); i++)
 	{
-		var c;
-		c.append(i.getFloatRed());
-		c.append(i.getFloatGreen());
-		c.append(i.getFloatBlue());
-		c.append(i.getFloatAlpha());
-		colors.append(c);
+		const Colour& c = sourceColors.getReference(i);
+		pixels[i * 4] = c.getFloatRed();
+		pixels[i * 4 + 1] = c.getFloatGreen();
+		pixels[i * 4 + 2] = c.getFloatBlue();
+		pixels[i * 4 + 3] = c.getFloatAlpha();
 	}
 
-	values.set(nullptr, colors); //using nullptr as placeholders for values not linked to a computed parameter
+	computedSlotsAreCurrent = true;
+	computedValuesAreCurrent = false;
 }
 
 void ColorComponent::updateComputedValues(HashMap<Parameter*, var>& values)
 {
-	var colValues = values[nullptr].clone(); //using nullptr as placeholders for values not linked to a computed parameter
+	syncComputedSlotsFromValues();
 
-	jassert(colValues.size() == resolution->intValue());
-	jassert(colValues[0].size() >= 4);
+	const int numColors = numComputedSlots / 4;
+	const float* pixels = computedSlots.getRawDataPointer();
 
+	jassert(numColors == resolution->intValue());
 
-	if (ObjectManager::getInstance()->blackOut->boolValue())
+	bool blackOut = ObjectManager::getInstance()->blackOut->boolValue();
+
+	if (blackOut)
 	{
-		var zeroVal;
-		zeroVal.append(0);
-		zeroVal.append(0);
-		zeroVal.append(0);
-		zeroVal.append(0);
-		colValues.getArray()->fill(zeroVal);
 		outColors.fill(Colours::black);
 	}
 	else
@@ -158,142 +183,129 @@ void ColorComponent::updateComputedValues(HashMap<Parameter*, var>& values)
 			if (dimmerComponent != nullptr) mult = dimmerComponent->mainParameter->floatValue();
 		}
 
-		for (int i = 0; i < colValues.size(); i++)
+		for (int i = 0; i < numColors && i < outColors.size(); i++)
 		{
-			if (colValues[i].size() < 4) continue;
-			var col;
-			col.append((float)colValues[i][0] * mult);
-			col.append((float)colValues[i][1] * mult);
-			col.append((float)colValues[i][2] * mult);
-			col.append((float)colValues[i][3] * mult);
-
-			outColors.set(i, Colour::fromFloatRGBA(col[0], col[1], col[2], col[3]));
+			const float* p = pixels + i * 4;
+			outColors.set(i, Colour::fromFloatRGBA(p[0] * mult, p[1] * mult, p[2] * mult, p[3] * mult));
 		}
 	}
 
 
-	if (colValues.size() > 0 && colValues[0].size() >= 4)
+	if (numColors > 0)
 	{
-		paramComputedMap[mainColor]->setValue(colValues[0]);
+		var mainValue;
+		for (int j = 0; j < 4; j++) mainValue.append(blackOut ? 0 : pixels[j]);
+		paramComputedMap[mainColor]->setValue(mainValue);
 	}
 }
 
 
-void ColorComponent::fillInterfaceDataInternal(Interface* i, var data, var params)
+void ColorComponent::fillInterfaceDataInternal(DMXInterface* di, uint8* channels, int channelOffset)
 {
-	if (DMXInterface* di = dynamic_cast<DMXInterface*>(i))
-	{
-		int channelOffset = params.getProperty("channelOffset", 0);
-		var channelsData = data.getProperty("channels", var());
+	Parameter* channelP = computedInterfaceMap[paramComputedMap[mainColor]];
+	if (channelP == nullptr || !channelP->enabled) return;
+	int channel = channelP->intValue();
+	int targetChannel = channelOffset + channel - 1; //convert local channel to 0-based
 
-		Parameter* channelP = computedInterfaceMap[paramComputedMap[mainColor]];
-		if (channelP == nullptr || !channelP->enabled) return;
-		int channel = channelP->intValue();
-		int targetChannel = channelOffset + channel - 1; //convert local channel to 0-based
+	ColorMode cm = (ColorMode)colorMode->intValue();
+	const int* indices = colorModeIndices[(int)cm];
 
-		ColorMode cm = (ColorMode)colorMode->intValue();
-		const int* indices = colorModeIndices[(int)cm];
+	FineMode fm = fineMode->getValueDataAsEnum<FineMode>();
 
-		FineMode fm = fineMode->getValueDataAsEnum<FineMode>();
+	int colorSize = 3;
 
-		int colorSize = 3;
+	switch (cm)
+	{
+	case HS:
+		colorSize = 2;
+		break;
+
+	case RGBW:
+	case WRGB:
+		colorSize = 4;
+		break;
+
+	default:
+		colorSize = 3;
+		break;
+	}
 
-		switch (cm)
-		{
-		case HS:
-			colorSize = 2;
-			break;
+	int finalColorSize = fm == None ? colorSize : colorSize * 2;
 
-		case RGBW:
-		case WRGB:
-			colorSize = 4;
-			break;
 
-		default:
-			colorSize = 3;
-			break;
-		}
+	GenericScopedLock lock(outColors.getLock());
+	const int numColors = outColors.size();
+	const Colour* colors = outColors.begin();
 
-		int finalColorSize = fm == None ? colorSize : colorSize * 2;
+	float* values = getConvertedValues(numColors * CONVERTED_STRIDE);
 
+	switch (cm)
+	{
+	case HS:
+		ColorHelpers::convertToHS(colors, numColors, values, CONVERTED_STRIDE);
+		break;
+
+	case RGBW:
+	case WRGB:
+		ColorHelpers::convertToRGBW(colors, numColors, ColorHelpers::getWhitePoint(whiteTemperature->intValue()), values, CONVERTED_STRIDE);
+		break;
+
+	case RGBAW:
+	case RGBWA:
+		ColorHelpers::convertToRGBWA(colors, numColors, ColorHelpers::getWhitePoint(whiteTemperature->intValue()), values, CONVERTED_STRIDE);
+		break;
+
+	case CMY:
+		ColorHelpers::convertToCMY(colors, numColors, values, CONVERTED_STRIDE);
+		break;
+
+	default:
+		ColorHelpers::convertToRGB(colors, numColors, values, CONVERTED_STRIDE);
+		break;
+	}
 
-		int temp = whiteTemperature->intValue();
+	for (int i = 0; i < numColors; i++)
+	{
+		const float* c = values + i * CONVERTED_STRIDE;
+		int ch = targetChannel + i * finalColorSize;
+		if (ch >= DMX_NUM_CHANNELS) break;
 
-		for (int i = 0; i < outColors.size(); i++)
+		if (fm == None && ch >= 0)
 		{
-			var c;
+			uint8* dest = channels + ch;
+			const int numChannels = jmin(colorSize, DMX_NUM_CHANNELS - ch);
+			for (int ci = 0; ci < numChannels; ci++) dest[ci] = ColorHelpers::toDMXValue(c[indices[ci]]);
+			continue;
+		}
 
-			switch (cm)
-			{
+		for (int ci = 0; ci < colorSize; ci++)
+		{
+			if (ch + ci >= DMX_NUM_CHANNELS) break;
 
-			case HS:
+			switch (fm)
 			{
-				float h, s, b;
-				outColors[i].getHSB(h, s, b);
-
-				c.append(h);
-				c.append(s);
-			}
-			break;
-
-			case RGBW:
-			case WRGB:
-				c = ColorHelpers::getRGBWFromRGB(outColors[i], temp);
+			case None:
+				setDMXChannelValue(channels, ch + ci, roundToInt(c[indices[ci]] * 255));
 				break;
 
-			case RGBAW:
-			case RGBWA:
-				c = ColorHelpers::getRGBWAFromRGB(outColors[i], temp);
-				break;
-
-			case CMY:
-				c.append(1 - outColors[i].getFloatRed());
-				c.append(1 - outColors[i].getFloatGreen());
-				c.append(1 - outColors[i].getFloatBlue());
-				break;
-
-			default:
-				c.append(outColors[i].getFloatRed());
-				c.append(outColors[i].getFloatGreen());
-				c.append(outColors[i].getFloatBlue());
-				break;
-			}
-
-			int ch = targetChannel + i * finalColorSize;
-
-			for (int ci = 0; ci < colorSize; ci++)
+			case Alternate:
+			case Follow:
 			{
-				if (ch + ci >= channelsData.size()) break;
-
-				switch (fm)
-				{
-				case None:
-					channelsData[ch + ci] = roundToInt((float)c[indices[ci]] * 255);
-					break;
+				int index1 = fm == Alternate ? ch + ci * 2 : ch + ci;
+				int index2 = fm == Alternate ? index1 + 1 : index1 + colorSize;
 
-				case Alternate:
-				case Follow:
-				{
-					int index1 = fm == Alternate ? ch + ci * 2 : ch + ci;
-					int index2 = fm == Alternate ? index1 + 1 : index1 + colorSize;
-
-					if (index2 >= channelsData.size()) break;
+				if (index2 >= DMX_NUM_CHANNELS) break;
 
-					float val = (float)c[indices[ci]] * 255;
+				float val = c[indices[ci]] * 255;
 
-					channelsData[index1] = floor(val);
-					channelsData[index2] = fmodf(val, 1) * 255;
+				setDMXChannelValue(channels, index1, floor(val));
+				setDMXChannelValue(channels, index2, fmodf(val, 1) * 255);
 
-				}
-				break;
-				}
+			}
+			break;
 			}
 		}
-
-		return;
 	}
-
-	ObjectComponent::fillInterfaceDataInternal(i, data, params);
 }
 
 void ColorComponent::onContainerParameterChangedInternal(Parameter* p)
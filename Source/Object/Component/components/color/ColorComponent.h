@@ -66,10 +66,13 @@ public:
 	void lerpFromSceneData(var startData, var endData, float weight);
 
 	void update() override;
+	bool isTimeDependent() override;
+	void fillComputedSlotLayout(Array<ComputedSlot>& layout) override;
 	void fillComputedValueMap(HashMap<Parameter*, var>& values) override;
 	void updateComputedValues(HashMap<Parameter*, var>& values) override;
 
-	virtual void fillInterfaceDataInternal(Interface* i, var data, var params) override;// (HashMap<int, float>& channelValueMap, int startChannel, bool 
+	using ObjectComponent::fillInterfaceDataInternal;
+	virtual void fillInterfaceDataInternal(DMXInterface* di, uint8* channels, int channelOffset) override;
 
 	//virtual void fillOutValueMap(HashMap<int, float>& channelValueMap, int startChannel, bool ignoreChannelOffset = false) override;
 
@@ -39,6 +39,9 @@ void DimmerComponent::updateComputedValues(HashMap<Parameter*, var>& values)
 {
 	if (curve.enabled->boolValue())
 	{
+		syncComputedValuesFromSlots();
+		invalidateComputedSlots();
+
 		Parameter* compValue = paramComputedMap[value];
 		float val = values[compValue];
 		curve.position->setValue(val);
@@ -49,25 +52,25 @@ void DimmerComponent::updateComputedValues(HashMap<Parameter*, var>& values)
 	ObjectComponent::updateComputedValues(values);
 }
 
-void DimmerComponent::fillInterfaceData(Interface* i, var data, var params)
+void DimmerComponent::fillInterfaceData(DMXInterface* di, uint8* channels, int channelOffset)
 {
-	ObjectComponent::fillInterfaceData(i, data, params);
+	ObjectComponent::fillInterfaceData(di, channels, channelOffset);
 
 	if (ObjectManager::getInstance()->blackOut->boolValue()) return;
+	if (!useFineValue->boolValue()) return;
 
-	if (DMXInterface* di = dynamic_cast<DMXInterface*>(i))
-	{
-		int channelOffset = params.getProperty("channelOffset", 0);
-		var channelsData = data.getProperty("channels", var());
-
-		Parameter* channelP = computedInterfaceMap[paramComputedMap[value]];
-		if (channelP == nullptr || !channelP->enabled) return;
-		int channel = channelP->intValue();
-		int targetChannel = channelOffset + channel - 1; //convert local channel to 0-based
+	Parameter* cp = paramComputedMap[value];
+	Parameter* channelP = computedInterfaceMap[cp];
+	if (channelP == nullptr || !channelP->enabled) return;
+	int channel = channelP->intValue();
+	int targetChannel = channelOffset + channel - 1; //convert local channel to 0-based
 
-
-		float pVal = (float)channelsData[targetChannel];
-		channelsData[targetChannel] = floor(pVal);
-		if (useFineValue->boolValue() && targetChannel + 1 < channelsData.size()) channelsData[targetChannel + 1] = fmodf(pVal, 1) * 255;
+	if (const uint16* table = getResponseTable(computedParameters.indexOf(cp), cp))
+	{
+		setDMXChannelValue(channels, targetChannel + 1, getResponseValue(table, cp->floatValue()) & 0xFF);
+		return;
 	}
+
+	float pVal = getMappedValueForComputedParam(di, cp);
+	setDMXChannelValue(channels, targetChannel + 1, fmodf(pVal, 1) * 255);
 }
@@ -23,7 +23,8 @@ public:
 	Automation curve;
 
 	virtual void updateComputedValues(HashMap<Parameter*, var>& values) override;
-	virtual void fillInterfaceData(Interface* i, var data, var params) override;// (HashMap<int, float>& channelValueMap, int startChannel, bool 
+	using ObjectComponent::fillInterfaceData;
+	virtual void fillInterfaceData(DMXInterface* di, uint8* channels, int channelOffset) override;
 
 	String getTypeString() const override { return "Dimmer"; }
 	static DimmerComponent* create(Object* o, var params) { return new DimmerComponent(o, params); }
@@ -174,6 +174,9 @@ void OrientationComponent::updateComputedValues(HashMap<Parameter*, var>& values
 		{
 			target->setEnabled(cm == TARGET);
 
+			syncComputedValuesFromSlots();
+			invalidateComputedSlots();
+
 			Parameter* targetC = paramComputedMap[target];
 			Parameter* panC = paramComputedMap[pan];
 			Parameter* tiltC = paramComputedMap[tilt];
@@ -189,41 +192,27 @@ void OrientationComponent::updateComputedValues(HashMap<Parameter*, var>& values
 	ObjectComponent::updateComputedValues(values);
 }
 
-void OrientationComponent::fillInterfaceData(Interface* i, var data, var params)
+void OrientationComponent::fillInterfaceData(DMXInterface* di, uint8* channels, int channelOffset)
 {
-	ObjectComponent::fillInterfaceData(i, data, params);
+	ObjectComponent::fillInterfaceData(di, channels, channelOffset);
 
 	if (ObjectManager::getInstance()->blackOut->boolValue()) return;
+	if (!usePreciseChannels->boolValue()) return;
 
-	if (DMXInterface* di = dynamic_cast<DMXInterface*>(i))
-	{
-		int channelOffset = params.getProperty("channelOffset", 0);
-		var channelsData = data.getProperty("channels", var());
-
-		if (usePreciseChannels->boolValue())
-		{
-			Array<Parameter*> panTilts{ pan, tilt };
-
-			for (auto& p : panTilts)
-			{
-
-				Parameter* pCh = computedInterfaceMap[paramComputedMap[p]];
-				if (pCh != nullptr || pCh->enabled)
-				{
-					int pChannel = channelOffset + pCh->intValue() - 1;
+	Parameter* panTilts[2]{ pan, tilt };
 
-					float pVal = (float)channelsData[pChannel];
-					int pVal1 = floor(pVal);
-					int pVal2 = fmodf(pVal, 1) * 255;
+	for (auto& p : panTilts)
+	{
+		Parameter* cp = paramComputedMap[p];
+		Parameter* pCh = computedInterfaceMap[cp];
+		if (pCh == nullptr || !pCh->enabled) continue;
 
-					channelsData[pChannel] = pVal1;
-					channelsData[pChannel + 1] = pVal2;
+		int pChannel = channelOffset + pCh->intValue() - 1;
+		float pVal = getMappedValueForComputedParam(di, cp);
 
-				}
-			}
-		}
+		setDMXChannelValue(channels, pChannel, floor(pVal));
+		setDMXChannelValue(channels, pChannel + 1, fmodf(pVal, 1) * 255);
 	}
-
 }
 
 var OrientationComponent::getMappedValueForComputedParam(Interface* i, Parameter* cp)
@@ -60,9 +60,11 @@ public:
 
 	void onContainerParameterChangedInternal(Parameter*) override;
 	bool checkDefaultInterfaceParamEnabled(Parameter* p) override { return p == pan || p == tilt; }
+	bool canUseResponseCurve(Parameter* p) override { return false; } //pan and tilt are mapped to their own DMX ranges
 
 	void updateComputedValues(HashMap<Parameter*, var>& values) override;
-	void fillInterfaceData(Interface* i, var data, var params) override;
+	using ObjectComponent::fillInterfaceData;
+	void fillInterfaceData(DMXInterface* di, uint8* channels, int channelOffset) override;
 
 	var getMappedValueForComputedParam(Interface* i, Parameter* cp) override;
 
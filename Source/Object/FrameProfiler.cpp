@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    FrameProfiler.cpp
+    Created: 18 Oct 2026 10:12:41am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Object/ObjectIncludes.h"
+
+FrameProfiler::FrameProfiler() :
+    EnablingControllableContainer("Profiler"),
+    isProfiling(false),
+    framesSinceStatsUpdate(0)
+{
+    enabled->setDefaultValue(false);
+    saveAndLoadRecursiveData = false;
+
+    overruns = addIntParameter("Overruns", "Number of frames that took longer than the update rate allows since the profiler was enabled or reset", 0, 0);
+    overruns->setControllableFeedbackOnly(true);
+    overruns->isSavable = false;
+    resetStats = addTrigger("Reset", "Reset all the statistics");
+
+    const char* stageNames[NUM_STAGES] = { "Prepare Send", "Raw Data", "Compute", "Local Effects", "Scenes", "Groups", "Sequences", "Global Effects", "Finish Send", "Frame" };
+    for (int i = 0; i < NUM_STAGES; i++)
+    {
+        StageStats* s = new StageStats(stageNames[i]);
+        stages.add(s);
+        addChildControllableContainer(s);
+    }
+
+    reset();
+}
+
+FrameProfiler::~FrameProfiler()
+{
+}
+
+void FrameProfiler::beginFrame()
+{
+    isProfiling = enabled->boolValue();
+    if (!isProfiling) return;
+    for (int i = 0; i < NUM_STAGES; i++) stageTicks[i] = 0;
+}
+
+void FrameProfiler::addTime(Stage stage, int64 ticks)
+{
+    stageTicks[stage] += ticks;
+}
+
+void FrameProfiler::endFrame(double frameBudgetMs)
+{
+    if (!isProfiling) return;
+
+    for (int i = 0; i < NUM_STAGES; i++) stages[i]->addValue((float)(Time::highResolutionTicksToSeconds(stageTicks[i].get()) * 1000));
+
+    if (Time::highResolutionTicksToSeconds(stageTicks[FRAME].get()) * 1000 > frameBudgetMs) overruns->setValue(overruns->intValue() + 1);
+
+    framesSinceStatsUpdate++;
+    if (framesSinceStatsUpdate < STATS_UPDATE_INTERVAL) return;
+
+    framesSinceStatsUpdate = 0;
+    for (auto& s : stages) s->updateStats();
+}
+
+void FrameProfiler::reset()
+{
+    overruns->setValue(0);
+    framesSinceStatsUpdate = 0;
+    for (auto& s : stages) s->reset();
+}
+
+void FrameProfiler::onContainerTriggerTriggered(Trigger* t)
+{
+    EnablingControllableContainer::onContainerTriggerTriggered(t);
+    if (t == resetStats) reset();
+}
+
+
+FrameProfiler::StageStats::StageStats(const String& name) :
+    ControllableContainer(name),
+    numValues(0),
+    writeIndex(0)
+{
+    minTime = addFloatParameter("Min", "Minimum time spent in this stage over the last frames, in milliseconds", 0, 0);
+    avgTime = addFloatParameter("Average", "Average time spent in this stage over the last frames, in milliseconds", 0, 0);
+    p99Time = addFloatParameter("P99", "99th percentile of the time spent in this stage over the last frames, in milliseconds", 0, 0);
+
+    for (auto& p : { minTime, avgTime, p99Time })
+    {
+        p->setControllableFeedbackOnly(true);
+        p->isSavable = false;
+    }
+}
+
+void FrameProfiler::StageStats::addValue(float ms)
+{
+    history[writeIndex] = ms;
+    writeIndex = (writeIndex + 1) % HISTORY_SIZE;
+    numValues = jmin(numValues + 1, (int)HISTORY_SIZE);
+}
+
+void FrameProfiler::StageStats::updateStats()
+{
+    if (numValues == 0) return;
+
+    float sorted[HISTORY_SIZE];
+    std::copy(history, history + numValues, sorted);
+    std::sort(sorted, sorted + numValues);
+
+    float total = 0;
+    for (int i = 0; i < numValues; i++) total += sorted[i];
+
+    minTime->setValue(sorted[0]);
+    avgTime->setValue(total / numValues);
+    p99Time->setValue(sorted[jmin(numValues - 1, (int)(numValues * .99f))]);
+}
+
+void FrameProfiler::StageStats::reset()
+{
+    numValues = 0;
+    writeIndex = 0;
+    minTime->setValue(0);
+    avgTime->setValue(0);
+    p99Time->setValue(0);
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    FrameProfiler.h
+    Created: 18 Oct 2026 10:12:41am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class FrameProfiler :
+    public EnablingControllableContainer
+{
+public:
+    FrameProfiler();
+    ~FrameProfiler();
+
+    enum Stage { PREPARE_SEND, RAW_DATA, COMPUTE, LOCAL_EFFECTS, SCENES, GROUPS, SEQUENCES, GLOBAL_EFFECTS, FINISH_SEND, FRAME, NUM_STAGES };
+    static const int HISTORY_SIZE = 256;
+    static const int STATS_UPDATE_INTERVAL = 10; //frames between two updates of the stats parameters
+
+    class StageStats :
+        public ControllableContainer
+    {
+    public:
+        StageStats(const String& name);
+        ~StageStats() {}
+
+        FloatParameter* minTime;
+        FloatParameter* avgTime;
+        FloatParameter* p99Time;
+
+        float history[HISTORY_SIZE];
+        int numValues;
+        int writeIndex;
+
+        void addValue(float ms);
+        void updateStats();
+        void reset();
+    };
+
+    IntParameter* overruns;
+    Trigger* resetStats;
+
+    OwnedArray<StageStats> stages;
+
+    //stage times of the current frame, in high resolution ticks. Compute stages can be timed from several threads at once
+    Atomic<int64> stageTicks[NUM_STAGES];
+    bool isProfiling;
+    int framesSinceStatsUpdate;
+
+    void beginFrame();
+    void addTime(Stage stage, int64 ticks);
+    void endFrame(double frameBudgetMs);
+    void reset();
+
+    void onContainerTriggerTriggered(Trigger* t) override;
+
+    class ScopedStageTimer
+    {
+    public:
+        ScopedStageTimer(FrameProfiler* profiler, Stage stage) :
+            profiler(profiler->isProfiling ? profiler : nullptr),
+            stage(stage),
+            startTicks(this->profiler != nullptr ? Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedStageTimer()
+        {
+            if (profiler != nullptr) profiler->addTime(stage, Time::getHighResolutionTicks() - startTicks);
+        }
+
+    private:
+        FrameProfiler* profiler;
+        Stage stage;
+        int64 startTicks;
+    };
+};
@@ -22,7 +22,7 @@ Group::Group(String name) :
 
 Group::~Group()
 {
-
+    FilterManager::invalidateAllCaches();
 }
 
 void Group::generateRandomIDs()
@@ -58,6 +58,11 @@ void ObjectGroup::itemsRemoved(Array<ObjectTarget*> items)
 	generateRandomIDs();
 }
 
+void ObjectGroup::itemsReordered()
+{
+    rebuildLocalIDMap();
+}
+
 void ObjectGroup::targetChanged(Object* newTarget, Object* previousTarget)
 {
     if (previousTarget != nullptr) unregisterLinkedInspectable(previousTarget);
@@ -83,6 +88,39 @@ void ObjectGroup::rebuildLinkedObjects()
     }
 }
 
+void ObjectGroup::rebuildLocalIDMap()
+{
+    LocalIDMap* newMap = new LocalIDMap();
+    int index = 0;
+    for (auto& t : objectsCC.items)
+    {
+        if (!t->objectRef.wasObjectDeleted() && t->currentObject != nullptr && !newMap->ids.contains(t->currentObject)) newMap->ids.set(t->currentObject, { index, randomIDs[index] });
+        index++;
+    }
+
+    ObjectManager* om = ObjectManager::getInstanceWithoutCreating();
+
+    //maps retired before the current frame started can't be read anymore
+    for (int i = localIDMaps.size() - 1; i >= 0; i--)
+    {
+        LocalIDMap* m = localIDMaps.getUnchecked(i);
+        if (m != localIDMap.get() && (om == nullptr || m->retiredFrame != om->frameCount.get())) localIDMaps.remove(i);
+    }
+
+    LocalIDMap* oldMap = localIDMap.get();
+    localIDMaps.add(newMap);
+    localIDMap = newMap;
+    if (oldMap != nullptr) oldMap->retiredFrame = om != nullptr ? om->frameCount.get() : 0;
+
+    FilterManager::invalidateAllCaches();
+}
+
+void ObjectGroup::generateRandomIDs()
+{
+    Group::generateRandomIDs();
+    rebuildLocalIDMap();
+}
+
 void ObjectGroup::addObject(Object* o)
 {
     if (o == nullptr) return;
@@ -115,36 +153,29 @@ void ObjectGroup::addObjects(Array<Object*> oList)
 
 ObjectTarget * ObjectGroup::getTargetForObject(Object* o)
 {
-    for (auto& t : objectsCC.items)
-    {
-        if (!t->objectRef.wasObjectDeleted() && t->currentObject == o) return t;
-    }
-
-    return nullptr;
+    int index = getLocalIDForObject(o);
+    return index == -1 ? nullptr : objectsCC.items[index];
 }
 
 bool ObjectGroup::containsObject(Object* o)
 {
-    return getTargetForObject(o) != nullptr;
+    return getLocalIDForObject(o) != -1;
 }
 
 int ObjectGroup::getLocalIDForObject(Object* o)
 {
-    int index = 0;
-    for (auto& t : objectsCC.items)
-    {
-        if (!t->objectRef.wasObjectDeleted() && t->currentObject == o) return index;
-        index++;
-    }
-    return -1;
+    if (o == nullptr) return -1;
+
+    LocalIDMap* m = localIDMap.get();
+    return m != nullptr ? m->ids[o].localID : -1;
 }
 
 int ObjectGroup::getRandomIDForObject(Object* o)
 {
-    int index = getLocalIDForObject(o);
-    if (index == -1) return -1;
+    if (o == nullptr) return -1;
 
-    return randomIDs[index];
+    LocalIDMap* m = localIDMap.get();
+    return m != nullptr ? m->ids[o].randomID : -1;
 }
 
 int ObjectGroup::getNumObjects()
@@ -57,13 +57,35 @@ public:
 
     BaseManager<ObjectTarget> objectsCC;
 
+    //Object to local and random IDs, rebuilt on the message thread whenever the membership or order changes.
+    //Update threads read the current map without locking, replaced maps are kept until the next frame
+    struct LocalIDMap :
+        public ReferenceCountedObject
+    {
+        struct IDs
+        {
+            int localID = -1;
+            int randomID = -1;
+        };
+
+        HashMap<Object*, IDs> ids;
+        uint32 retiredFrame = 0;
+    };
+
+    Atomic<LocalIDMap*> localIDMap;
+    ReferenceCountedArray<LocalIDMap> localIDMaps; //current and retired maps
+
     void itemAdded(ObjectTarget* i) override;
     void itemsAdded(Array<ObjectTarget*> items) override;
     void itemRemoved(ObjectTarget * i) override;
     void itemsRemoved(Array<ObjectTarget*> items) override;
+    void itemsReordered() override;
     void targetChanged(Object * newTarget, Object * previousTarget) override;
 
     void rebuildLinkedObjects();
+    void rebuildLocalIDMap();
+
+    void generateRandomIDs() override;
 
     void addObject(Object* o);
     void addObjects(Array<Object*> oList);
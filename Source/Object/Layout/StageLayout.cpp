@@ -9,7 +9,9 @@
 */
 
 StageLayout::StageLayout() :
-    BaseItem("Layout", false)
+    BaseItem("Layout", false),
+    indexVersion(-1),
+    cellSize(1)
 {
     saveLayout();
 }
@@ -30,15 +32,118 @@ void StageLayout::saveLayout()
 {
     layoutData = var(new DynamicObject());
     for (auto& o : ObjectManager::getInstance()->items) layoutData.getDynamicObject()->setProperty(o->shortName, o->stagePosition->getValue());
+    FilterManager::invalidateAllCaches();
 }
 
 Vector3D<float> StageLayout::getObjectPosition(Object* o)
+{
+    updateIndexIfNeeded();
+
+    GenericScopedLock lock(indexLock);
+    if (objectIndices.contains(o)) return indexedObjects.getReference(objectIndices[o]).position;
+    return getStoredPosition(o); //not in the object manager (yet)
+}
+
+Vector3D<float> StageLayout::getStoredPosition(Object* o)
 {
     var p = layoutData.getProperty(o->shortName, var());
     if (p.isVoid()) return Vector3D<float>();
     return Vector3D<float>(p[0], p[1], p[2]);
 }
 
+void StageLayout::getObjectsInRadius(Vector3D<float> center, float radius, Array<IndexedObject>& result)
+{
+    result.clearQuick();
+    updateIndexIfNeeded();
+
+    GenericScopedLock lock(indexLock);
+
+    const float radius2 = radius * radius;
+    auto isInRadius = [center, radius2](const IndexedObject& io) { return (io.position - center).lengthSquared() <= radius2; };
+
+    const int minX = (int)std::floor((center.x - radius - gridMin.x) / cellSize);
+    const int minY = (int)std::floor((center.y - radius - gridMin.y) / cellSize);
+    const int minZ = (int)std::floor((center.z - radius - gridMin.z) / cellSize);
+    const int maxX = (int)std::floor((center.x + radius - gridMin.x) / cellSize);
+    const int maxY = (int)std::floor((center.y + radius - gridMin.y) / cellSize);
+    const int maxZ = (int)std::floor((center.z + radius - gridMin.z) / cellSize);
+
+    //the radius covers more cells than there are objects, checking them all is cheaper
+    const int64 numCells = (int64)(maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1);
+    if (numCells > indexedObjects.size())
+    {
+        for (auto& io : indexedObjects) if (isInRadius(io)) result.add(io);
+        return;
+    }
+
+    for (int x = minX; x <= maxX; x++)
+    {
+        for (int y = minY; y <= maxY; y++)
+        {
+            for (int z = minZ; z <= maxZ; z++)
+            {
+                int64 key = getCellKey(x, y, z);
+                if (!grid.contains(key)) continue;
+                for (auto& i : grid.getReference(key))
+                {
+                    const IndexedObject& io = indexedObjects.getReference(i);
+                    if (isInRadius(io)) result.add(io);
+                }
+            }
+        }
+    }
+}
+
+void StageLayout::updateIndexIfNeeded()
+{
+    if (indexVersion.get() == FilterManager::contextVersion.get()) return;
+
+    GenericScopedLock lock(indexLock);
+    int version = FilterManager::contextVersion.get(); //read before building, a change during the build triggers another one
+    if (indexVersion.get() == version) return;
+    rebuildIndex();
+    indexVersion = version;
+}
+
+void StageLayout::rebuildIndex()
+{
+    indexedObjects.clearQuick();
+    objectIndices.clear();
+    grid.clear();
+
+    Vector3D<float> minPos, maxPos;
+    for (auto& o : ObjectManager::getInstance()->items)
+    {
+        Vector3D<float> p = getStoredPosition(o);
+        if (indexedObjects.isEmpty()) minPos = maxPos = p;
+        minPos = Vector3D<float>(jmin(minPos.x, p.x), jmin(minPos.y, p.y), jmin(minPos.z, p.z));
+        maxPos = Vector3D<float>(jmax(maxPos.x, p.x), jmax(maxPos.y, p.y), jmax(maxPos.z, p.z));
+
+        objectIndices.set(o, indexedObjects.size());
+        indexedObjects.add({ o, p });
+    }
+
+    //aim for a few objects per cell, whatever the shape of the rig
+    Vector3D<float> extent = maxPos - minPos;
+    float maxExtent = jmax(extent.x, extent.y, extent.z);
+    gridMin = minPos;
+    cellSize = jmax(maxExtent / jmax(1.f, std::cbrt((float)indexedObjects.size())), .01f);
+
+    for (int i = 0; i < indexedObjects.size(); i++)
+    {
+        Vector3D<float> cp = (indexedObjects[i].position - gridMin) / cellSize;
+        int64 key = getCellKey((int)std::floor(cp.x), (int)std::floor(cp.y), (int)std::floor(cp.z));
+        if (!grid.contains(key)) grid.set(key, Array<int>());
+        grid.getReference(key).add(i);
+    }
+}
+
+int64 StageLayout::getCellKey(int x, int y, int z) const
+{
+    //21 bits per axis, way more cells than any rig will ever use
+    return ((int64)(x & 0x1FFFFF) << 42) | ((int64)(y & 0x1FFFFF) << 21) | (int64)(z & 0x1FFFFF);
+}
+
 var StageLayout::getJSONData()
 {
     var data = BaseItem::getJSONData();
@@ -49,4 +154,5 @@ var StageLayout::getJSONData()
 void StageLayout::loadJSONDataItemInternal(var data)
 {
     layoutData = data.getProperty("layoutData", var());
+    FilterManager::invalidateAllCaches();
 }
\ No newline at end of file
@@ -21,10 +21,32 @@ public:
 
     var layoutData;
 
+    //Positions resolved from layoutData, indexed in a uniform grid for radius queries.
+    //Rebuilt lazily when layouts, object names or objects change (see FilterManager::contextVersion)
+    struct IndexedObject
+    {
+        Object* object;
+        Vector3D<float> position;
+    };
+
+    CriticalSection indexLock;
+    Atomic<int> indexVersion;
+    Array<IndexedObject> indexedObjects;
+    HashMap<Object*, int> objectIndices;
+    HashMap<int64, Array<int>> grid;
+    Vector3D<float> gridMin;
+    float cellSize;
+
     void loadLayout();
     void saveLayout();
 
     Vector3D<float> getObjectPosition(Object * o);
+    Vector3D<float> getStoredPosition(Object* o);
+    void getObjectsInRadius(Vector3D<float> center, float radius, Array<IndexedObject>& result);
+
+    void updateIndexIfNeeded();
+    void rebuildIndex();
+    int64 getCellKey(int x, int y, int z) const;
 
     var getJSONData() override;
     void loadJSONDataItemInternal(var data) override;
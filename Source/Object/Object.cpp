@@ -14,11 +14,19 @@
 #include "Scene/SceneIncludes.h"
 #include "Sequence/SequenceIncludes.h"
 
+CriticalSection Object::stateIndexLock;
+Array<int> Object::freeStateIndices;
+int Object::numStateIndices = 0;
+
 Object::Object(var params) :
 	BaseItem(params.getProperty("name", "Object")),
 	objectType(params.getProperty("type", "Object").toString()),
 	objectData(params),
 	previousID(-1),
+	stateIndex(acquireStateIndex()),
+	isDirty(true),
+	hasPendingValues(false),
+	isProcessingOnWorker(false),
 	slideManipParameter(nullptr)
 {
 	saveAndLoadRecursiveData = true;
@@ -135,6 +143,22 @@ Object::Object(var params) :
 
 Object::~Object()
 {
+	FilterManager::invalidateAllCaches(); //cached filter results are keyed by pointer
+	ParameterLink::invalidateSources(); //same for resolved links
+	releaseStateIndex(stateIndex);
+}
+
+int Object::acquireStateIndex()
+{
+	GenericScopedLock lock(stateIndexLock);
+	if (!freeStateIndices.isEmpty()) return freeStateIndices.removeAndReturn(freeStateIndices.size() - 1);
+	return numStateIndices++;
+}
+
+void Object::releaseStateIndex(int index)
+{
+	GenericScopedLock lock(stateIndexLock);
+	freeStateIndices.add(index);
 }
 
 void Object::clearItem()
@@ -191,6 +215,8 @@ ObjectComponent* Object::getComponentForType(ComponentType t)
 void Object::onContainerParameterChangedInternal(Parameter* p)
 {
 	BaseItem::onContainerParameterChangedInternal(p);
+	isDirty = true;
+
 	if (p == targetInterface)
 	{
 		rebuildInterfaceParams();
@@ -199,10 +225,14 @@ void Object::onContainerParameterChangedInternal(Parameter* p)
 	{
 		objectListeners.call(&ObjectListener::objectIDChanged, this, previousID);
 		previousID = globalID->intValue();
+		FilterManager::invalidateAllCaches();
+		ParameterLink::invalidateSources();
 	}
 	else if (p == stagePosition)
 	{
 		viewUIPosition->setPoint(stagePosition->x, stagePosition->z);
+		FilterManager::invalidateAllCaches();
+		ParameterLink::invalidateSources();
 	}
 	else if (p == viewUIPosition)
 	{
@@ -215,8 +245,19 @@ void Object::onContainerParameterChangedInternal(Parameter* p)
 	}
 }
 
+void Object::onContainerNiceNameChanged()
+{
+	BaseItem::onContainerNiceNameChanged();
+	FilterManager::invalidateAllCaches(); //layout positions are stored by name
+}
+
 void Object::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
 {
+	//computed parameters are also notified here, this gives one more compute after each change so components depending on each other (color using dimmer) settle
+	isDirty = true;
+
+	if (cc == customParams.get()) ParameterLink::invalidateSources();
+
 	if (cc == sourceInterfaceParamsRef)
 	{
 		if (Parameter* p = dynamic_cast<Parameter*>(c))
@@ -231,22 +272,44 @@ void Object::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Con
 
 
 
+bool Object::canComputeComponentValues()
+{
+	return enabled->boolValue() && !Engine::mainEngine->isLoadingFile && !Engine::mainEngine->isClearing;
+}
+
+bool Object::shouldRecomputeComponentValues()
+{
+	ObjectManager* om = ObjectManager::getInstance();
+
+	bool dirty = isDirty.exchange(false);
+	bool result = !om->onlyComputeChanges->boolValue() || dirty || om->forceComputeThisFrame || isTimeDependent() || om->isAffectedByTimeDependentEffect(this);
+
+	if (result) ++om->numComputedObjects;
+	else ++om->numSkippedObjects;
+	return result;
+}
+
+bool Object::isTimeDependent()
+{
+	for (auto& c : componentManager->items) if (c->enabled->boolValue() && c->isTimeDependent()) return true;
+	for (auto& e : effectManager->items) if (e->enabled->boolValue() && e->isTimeDependent()) return true;
+	return false;
+}
+
 void Object::checkAndComputeComponentValuesIfNeeded()
 {
-	if (!enabled->boolValue() || Engine::mainEngine->isLoadingFile || Engine::mainEngine->isClearing) return;
+	if (!canComputeComponentValues()) return;
 
-	for (auto& c : componentManager->items)
+	if (shouldRecomputeComponentValues())
 	{
-		if (!c->enabled->boolValue()) continue;
-		//if (c->isDirty || effectManager.items.size() > 0 || GlobalEffectManager::getInstance()->items.size() > 0);
-		 //to do here, implement a cleaner way to know if an object should recompute (effects may not need constant recompute, and are not targetting all components.)
-		computeComponentValues(c); //right now, always compute
+		for (auto& c : componentManager->items)
+		{
+			if (!c->enabled->boolValue()) continue;
+			computeComponentValues(c);
+		}
 	}
 
-	if (Interface* i = dynamic_cast<Interface*>(targetInterface->targetContainer.get()))
-	{
-		i->sendValuesForObject(this);
-	}
+	sendValuesToInterface(); //interfaces may clear their data each frame, so always send even if nothing was recomputed
 }
 
 void Object::computeComponentValues(ObjectComponent* c)
@@ -254,33 +317,119 @@ void Object::computeComponentValues(ObjectComponent* c)
 	if (!c->enabled->boolValue()) return;
 
 	c->update();
-	HashMap<Parameter*, var> values;
+	HashMap<Parameter*, var>& values = c->computedValues;
+	values.clear();
 	c->fillComputedValueMap(values);
 
-	if (values.size() > 0)
+	if (c->hasComputedValues())
 	{
-		if (!ObjectManager::getInstance()->blackOut->boolValue())
-		{
+		processComponentValues(c, values);
+		c->updateComputedValues(values);
+	}
+}
 
-			//local effects
-			effectManager->processComponent(this, c, values);
+void Object::processComponentValues(ObjectComponent* c, HashMap<Parameter*, var>& values)
+{
+	ObjectManager* om = ObjectManager::getInstance();
+	if (om->blackOut->boolValue()) return;
 
-			//scene effects
-			SceneManager::getInstance()->processComponent(this, c, values);
+	FrameProfiler* profiler = &om->profiler;
 
-			//group effects
-			GroupManager::getInstance()->processComponent(this, c, values); //to optimize with group registration on add/remove and not checking always at compute time
+	//local effects
+	{
+		FrameProfiler::ScopedStageTimer timer(profiler, FrameProfiler::LOCAL_EFFECTS);
+		effectManager->processComponent(this, c, values);
+	}
 
-			//global effects
-			GlobalSequenceManager::getInstance()->processComponent(this, c, values);
-			GlobalEffectManager::getInstance()->processComponent(this, c, values);
+	//scene effects
+	{
+		FrameProfiler::ScopedStageTimer timer(profiler, FrameProfiler::SCENES);
+		SceneManager::getInstance()->processComponent(this, c, values);
+	}
 
+	//group effects
+	{
+		FrameProfiler::ScopedStageTimer timer(profiler, FrameProfiler::GROUPS);
+		GroupManager::getInstance()->processComponent(this, c, values); //to optimize with group registration on add/remove and not checking always at compute time
+	}
+
+	//global effects
+	{
+		FrameProfiler::ScopedStageTimer timer(profiler, FrameProfiler::SEQUENCES);
+		GlobalSequenceManager::getInstance()->processComponent(this, c, values);
+	}
 
+	{
+		FrameProfiler::ScopedStageTimer timer(profiler, FrameProfiler::GLOBAL_EFFECTS);
+		GlobalEffectManager::getInstance()->processComponent(this, c, values);
+	}
+}
+
+void Object::processAllComponentValues()
+{
+	isProcessingOnWorker = true;
+
+	for (auto& c : componentManager->items)
+	{
+		c->computedValues.clear();
+		if (!c->enabled->boolValue()) continue;
+
+		c->update();
+		c->fillComputedValueMap(c->computedValues);
+		if (c->hasComputedValues()) processComponentValues(c, c->computedValues);
+	}
+
+	isProcessingOnWorker = false;
+	hasPendingValues = true;
+}
+
+void Object::applyAllComponentValues()
+{
+	if (hasPendingValues)
+	{
+		for (auto& c : componentManager->items)
+		{
+			if (!c->enabled->boolValue() || !c->hasComputedValues()) continue;
+			c->updateComputedValues(c->computedValues);
 		}
+		hasPendingValues = false;
+	}
 
-		c->updateComputedValues(values);
+	for (int i = 0; i < pendingVizParameters.size(); i++)
+	{
+		if (Parameter* p = pendingVizParameters[i].get()) p->setValue(pendingVizValues[i]);
 	}
+	pendingVizParameters.clearQuick();
+	pendingVizValues.clearQuick();
 
+	sendValuesToInterface();
+}
+
+void Object::setVizValue(Parameter* p, const var& value)
+{
+	if (p == nullptr) return;
+
+	if (!isProcessingOnWorker)
+	{
+		p->setValue(value);
+		return;
+	}
+
+	int index = pendingVizParameters.indexOf(p);
+	if (index == -1)
+	{
+		pendingVizParameters.add(p);
+		pendingVizValues.add(value);
+	}
+	else pendingVizValues.set(index, value);
+}
+
+void Object::sendValuesToInterface()
+{
+	if (Interface* i = dynamic_cast<Interface*>(targetInterface->targetContainer.get()))
+	{
+		i->sendValuesForObject(this);
+	}
 }
 
 var Object::getSceneData()
@@ -318,9 +467,13 @@ var Object::getVizData()
 
 void Object::componentsChanged()
 {
+	isDirty = true;
+
 	if (DimmerComponent* ic = getComponent<DimmerComponent>()) slideManipParameter = ic->value;
 	else slideManipParameter = nullptr;
 
+	if (Interface* i = (Interface*)targetInterface->targetContainer.get()) i->objectComponentsChanged(this);
+
 	if (!isCurrentlyLoadingData)
 	{
 		if (Interface* i = (Interface*)targetInterface->targetContainer.get()) for (auto& c : componentManager->items) c->rebuildInterfaceParams(i);
@@ -43,6 +43,19 @@ public:
 	IntParameter* globalID;
 	int previousID;
 
+	//Dense index, stable for the life of the object, so parameter links can keep per object values in arrays instead of maps.
+	//Indices of destroyed objects are reused, destroying an object invalidates link sources
+	int stateIndex;
+
+	static CriticalSection stateIndexLock;
+	static Array<int> freeStateIndices;
+	static int numStateIndices;
+
+	static int acquireStateIndex();
+	static void releaseStateIndex(int index);
+
+	Atomic<bool> isDirty; //set on any change inside this object, cleared when values are recomputed
+
 	BoolParameter* excludeFromScenes;
 
 	Point3DParameter* stagePosition;
@@ -68,9 +81,26 @@ public:
 
 	void onContainerParameterChangedInternal(Parameter* p) override;
 	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
+	void onContainerNiceNameChanged() override;
 
+	bool canComputeComponentValues();
+	bool shouldRecomputeComponentValues();
+	bool isTimeDependent();
 	void checkAndComputeComponentValuesIfNeeded();
 	void computeComponentValues(ObjectComponent* c);
+	void processComponentValues(ObjectComponent* c, HashMap<Parameter*, var>& values);
+
+	//multithreaded update, processing is thread-safe per object, applying and sending is done on the update thread in object order
+	void processAllComponentValues();
+	void applyAllComponentValues();
+	void sendValuesToInterface();
+	bool hasPendingValues;
+
+	//effect visualisation values computed by update workers are kept here and set when the values are applied
+	bool isProcessingOnWorker;
+	Array<WeakReference<Parameter>> pendingVizParameters;
+	Array<var> pendingVizValues;
+	void setVizValue(Parameter* p, const var& value);
 
 	var getSceneData();
 	void updateSceneData(var& sceneData);
@@ -50,6 +50,7 @@
 #include "Layout/ui/StageLayoutUI.cpp"
 
 #include "Object.cpp"
+#include "FrameProfiler.cpp"
 #include "ObjectManager.cpp"
 #include "ui/ObjectChainVizUI.cpp"
 #include "ui/ObjectGridUI.cpp"
@@ -45,6 +45,7 @@
 
 
 #include "Object.h"
+#include "FrameProfiler.h"
 #include "ObjectManager.h"
 #include "ui/ObjectChainVizUI.h"
 #include "ui/ObjectUI.h"
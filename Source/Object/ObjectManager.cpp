@@ -9,6 +9,8 @@
 */
 
 #include "Object/ObjectIncludes.h"
+#include "Effect/EffectIncludes.h"
+#include "Scene/SceneIncludes.h"
 #include "Sequence/SequenceIncludes.h"
 
 juce_ImplementSingleton(ObjectManager);
@@ -16,6 +18,8 @@ juce_ImplementSingleton(ObjectManager);
 ObjectManager::ObjectManager() :
 	BaseManager("Objects"),
 	Thread("ObjectManager"),
+	forceComputeAll(true),
+	forceComputeThisFrame(true),
 	customParams("Custom Parameters", false, false, true, true)
 {
 	itemDataType = "Object";
@@ -27,6 +31,16 @@ ObjectManager::ObjectManager() :
 	defaultFlashValue = addFloatParameter("Flash Value", "Flash Value", .5f, 0, 1);
 	blackOut = addBoolParameter("Black Out", "Force 0 on all computed values", false);
 	updateRate = addIntParameter("Update Rate", "General update rate", 50, 1, 200);
+	multiThreadedUpdate = addBoolParameter("Multithreaded Update", "If checked, objects will be computed in parallel on multiple threads. Values are still sent to interfaces in object order.", false);
+	updateThreads = addIntParameter("Update Threads", "Number of threads used to compute objects when Multithreaded Update is enabled", jmax(1, SystemStats::getNumCpus()), 1, 64);
+	updateThreads->setEnabled(false);
+	onlyComputeChanges = addBoolParameter("Only Compute Changes", "If checked, objects are only recomputed when something affecting them has changed or when they are animated. Values are still sent to interfaces every frame.", false);
+	computedObjects = addIntParameter("Computed Objects", "Number of objects recomputed during the last update", 0, 0);
+	computedObjects->setControllableFeedbackOnly(true);
+	computedObjects->isSavable = false;
+	skippedObjects = addIntParameter("Skipped Objects", "Number of objects that didn't need to be recomputed during the last update", 0, 0);
+	skippedObjects->setControllableFeedbackOnly(true);
+	skippedObjects->isSavable = false;
 	filterActiveInScene = addBoolParameter("Show Only active", "Show only active objects in scene", false);
 	showIconForColor = addBoolParameter("Show Icon for Color", "Show icon for objects with Color Source", false);
 	alwaysShowNamesInUI = addBoolParameter("Always show names", "Always show names in UI", false);
@@ -35,6 +49,7 @@ ObjectManager::ObjectManager() :
 
 	addChildControllableContainer(&customParams);
 	addChildControllableContainer(&spatializer);
+	addChildControllableContainer(&profiler);
 
 	File f = File::getSpecialLocation(File::SpecialLocationType::userDocumentsDirectory).getChildFile(String(ProjectInfo::projectName) + "/objects");
 	if (!f.exists() || !f.isDirectory())
@@ -140,12 +155,14 @@ void ObjectManager::addItemInternal(Object* o, var data)
 	controllableContainers.move(controllableContainers.indexOf(&customParams), 0);
 	o->addObjectListener(this);
 	if (!isCurrentlyLoadingData) o->globalID->setValue(getFirstAvailableObjectID(o));
+	FilterManager::invalidateAllCaches();
 }
 
 void ObjectManager::addItemsInternal(Array<Object*> items, var data)
 {
 	controllableContainers.move(controllableContainers.indexOf(&customParams), 0);
 	for (auto& o : items) o->addObjectListener(this);
+	FilterManager::invalidateAllCaches();
 	if (!isCurrentlyLoadingData)
 	{
 		for (int i = 0; i < items.size(); i++) items[i]->globalID->setValue(getFirstAvailableObjectID(items[i]));
@@ -155,11 +172,18 @@ void ObjectManager::addItemsInternal(Array<Object*> items, var data)
 void ObjectManager::removeItemInternal(Object* o)
 {
 	o->removeObjectListener(this);
+	FilterManager::invalidateAllCaches();
+	if (InterfaceManager* im = InterfaceManager::getInstanceWithoutCreating()) for (auto& i : im->items) i->objectRemoved(o);
 }
 
 void ObjectManager::removeItemsInternal(Array<Object*> items)
 {
 	for (auto& o : items) o->removeObjectListener(this);
+	FilterManager::invalidateAllCaches();
+	if (InterfaceManager* im = InterfaceManager::getInstanceWithoutCreating())
+	{
+		for (auto& i : im->items) for (auto& o : items) i->objectRemoved(o);
+	}
 }
 
 int ObjectManager::getFirstAvailableObjectID(Object* excludeObject)
@@ -188,6 +212,15 @@ void ObjectManager::objectIDChanged(Object* o, int previousID)
 void ObjectManager::onContainerParameterChanged(Parameter* p)
 {
 	if (p == lockUI) for (auto& i : items) i->isUILocked->setValue(lockUI->boolValue());
+	else if (p == multiThreadedUpdate) updateThreads->setEnabled(multiThreadedUpdate->boolValue());
+	else if (p == blackOut || p == onlyComputeChanges) setAllObjectsDirty();
+}
+
+void ObjectManager::onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c)
+{
+	BaseManager::onControllableFeedbackUpdate(cc, c);
+	if (cc == &customParams || cc == &spatializer) setAllObjectsDirty();
+	if (cc == &customParams || cc == &spatializer || (cc != nullptr && cc->parentContainer == &spatializer)) ParameterLink::invalidateSources();
 }
 
 var ObjectManager::getSceneData()
@@ -219,25 +252,162 @@ void ObjectManager::run()
 	{
 		long millisBefore = Time::getMillisecondCounter();
 
-		objectManagerListeners.call(&ObjectManagerListener::updateStart);
-		for (auto& i : InterfaceManager::getInstance()->items) i->prepareSendValues(); //interfaces should listen to updateStart and updateFinish
+		processFrame();
+
+		long millisAfter = Time::getMillisecondCounter();
+		long millisToSleep = jmax<long>(1, 1000.0 / updateRate->intValue() - (millisAfter - millisBefore));
+		sleep((int)millisToSleep);
+	}
+
+	stopUpdateWorkers();
+}
+
+void ObjectManager::processFrame()
+{
+	updateWorkersIfNeeded();
 
+	++frameCount;
+	profiler.beginFrame();
+
+	{
+		FrameProfiler::ScopedStageTimer frameTimer(&profiler, FrameProfiler::FRAME);
+
+		{
+			FrameProfiler::ScopedStageTimer timer(&profiler, FrameProfiler::PREPARE_SEND);
+			objectManagerListeners.call(&ObjectManagerListener::updateStart);
+			for (auto& i : InterfaceManager::getInstance()->items) i->prepareSendValues(); //interfaces should listen to updateStart and updateFinish
+		}
 
 		//Process raw data before objects data
-		GlobalSequenceManager::getInstance()->processRawData();
+		{
+			FrameProfiler::ScopedStageTimer timer(&profiler, FrameProfiler::RAW_DATA);
+			GlobalSequenceManager::getInstance()->processRawData();
+		}
 
-		items.getLock().enter();
-		for (auto& o : items)  o->checkAndComputeComponentValuesIfNeeded();
-		items.getLock().exit();
+		numComputedObjects = 0;
+		numSkippedObjects = 0;
 
+		{
+			FrameProfiler::ScopedStageTimer timer(&profiler, FrameProfiler::COMPUTE);
+			if (onlyComputeChanges->boolValue()) updateTimeDependencies();
 
-		objectManagerListeners.call(&ObjectManagerListener::updateFinish);
-		for (auto& i : InterfaceManager::getInstance()->items) i->finishSendValues(); //interfaces should listen to updateStart and updateFinish
+			items.getLock().enter();
+			if (multiThreadedUpdate->boolValue()) computeObjectsInParallel();
+			else for (auto& o : items)  o->checkAndComputeComponentValuesIfNeeded();
+			items.getLock().exit();
+		}
 
-		long millisAfter = Time::getMillisecondCounter();
-		long millisToSleep = jmax<long>(1, 1000.0 / updateRate->intValue() - (millisAfter - millisBefore));
-		sleep((int)millisToSleep);
+		uint32 now = Time::getMillisecondCounter();
+		if (now - lastStatsUpdateTime >= 500)
+		{
+			computedObjects->setValue(numComputedObjects.get());
+			skippedObjects->setValue(numSkippedObjects.get());
+			lastStatsUpdateTime = now;
+		}
+
+		{
+			FrameProfiler::ScopedStageTimer timer(&profiler, FrameProfiler::FINISH_SEND);
+			objectManagerListeners.call(&ObjectManagerListener::updateFinish);
+			for (auto& i : InterfaceManager::getInstance()->items) i->finishSendValues(); //interfaces should listen to updateStart and updateFinish
+		}
 	}
+
+	profiler.endFrame(1000.0 / updateRate->intValue());
+}
+
+void ObjectManager::updateWorkersIfNeeded()
+{
+	//this thread is also computing objects, so we only need numThreads - 1 workers
+	int numWorkers = multiThreadedUpdate->boolValue() ? updateThreads->intValue() - 1 : 0;
+	if (updateWorkers.size() == numWorkers) return;
+
+	stopUpdateWorkers();
+	for (int i = 0; i < numWorkers; i++)
+	{
+		ObjectUpdateWorker* w = new ObjectUpdateWorker(this, i);
+		updateWorkers.add(w);
+		w->startThread();
+	}
+}
+
+void ObjectManager::stopUpdateWorkers()
+{
+	for (auto& w : updateWorkers) w->signalThreadShouldExit();
+	for (auto& w : updateWorkers) w->startEvent.signal();
+	for (auto& w : updateWorkers) w->stopThread(1000);
+	updateWorkers.clear();
+}
+
+void ObjectManager::computeObjectsInParallel()
+{
+	objectsToProcess.clearQuick();
+	objectsToSend.clearQuick();
+	for (auto& o : items)
+	{
+		if (!o->canComputeComponentValues()) continue;
+		objectsToSend.add(o);
+		if (o->shouldRecomputeComponentValues()) objectsToProcess.add(o);
+	}
+
+	nextObjectIndex = 0;
+	numBusyWorkers = updateWorkers.size();
+	for (auto& w : updateWorkers) w->startEvent.signal();
+
+	processNextObjects();
+
+	if (updateWorkers.size() > 0) workersDoneEvent.wait();
+
+	//apply and send in object order, so interfaces always receive values in a deterministic order
+	for (auto& o : objectsToSend) o->applyAllComponentValues();
+}
+
+void ObjectManager::processNextObjects()
+{
+	while (true)
+	{
+		int index = (++nextObjectIndex) - 1;
+		if (index >= objectsToProcess.size()) break;
+		objectsToProcess.getUnchecked(index)->processAllComponentValues();
+	}
+}
+
+void ObjectManager::setAllObjectsDirty()
+{
+	forceComputeAll = true;
+}
+
+void ObjectManager::updateTimeDependencies()
+{
+	//objects outside of these effects' filters and without animated sources of their own can keep their last computed values
+	forceComputeThisFrame = forceComputeAll.exchange(false) || SceneManager::getInstance()->isCrossfading();
+
+	timeDependentEffects.clearQuick();
+	timeDependentSequences.clearQuick();
+	if (forceComputeThisFrame) return;
+
+	Scene* currentScene = SceneManager::getInstance()->currentScene;
+	BluxSequenceManager* sequenceManagers[2]{ GlobalSequenceManager::getInstance(), currentScene != nullptr ? currentScene->sequenceManager.get() : nullptr };
+	for (auto& sm : sequenceManagers)
+	{
+		if (sm == nullptr) continue;
+		for (auto& s : sm->items) if (s->enabled->boolValue() && s->isPlaying->boolValue()) timeDependentSequences.add((BluxSequence*)s);
+	}
+
+	for (auto& g : GlobalEffectManager::getInstance()->items) if (g->enabled->boolValue()) g->effectManager.fillTimeDependentEffects(timeDependentEffects);
+	for (auto& g : GroupManager::getInstance()->items) if (g->enabled->boolValue()) g->effectManager->fillTimeDependentEffects(timeDependentEffects);
+	if (Scene* s = SceneManager::getInstance()->currentScene) s->effectManager->fillTimeDependentEffects(timeDependentEffects);
+}
+
+bool ObjectManager::isAffectedByTimeDependentEffect(Object* o)
+{
+	for (auto& s : timeDependentSequences) if (s->isAffectingObject(o)) return true;
+
+	for (auto& e : timeDependentEffects)
+	{
+		if (e->parentGroup != nullptr && !e->parentGroup->containsObject(o)) continue;
+		if (e->isAffectingObject(o)) return true;
+	}
+	return false;
 }
 
 void ObjectManager::progress(URL::DownloadTask* task, int64 downloaded, int64 total)
@@ -347,6 +517,7 @@ void ObjectManagerCustomParams::rebuildCustomParams()
 	}
 
 	loadJSONData(oldData);
+	ParameterLink::invalidateSources();
 }
 
 var ObjectManagerCustomParams::getParamValueFor(WeakReference<Parameter> p)
@@ -414,3 +585,24 @@ SubObjectManager::SubObjectManager() :
 SubObjectManager::~SubObjectManager()
 {
 }
+
+
+// UPDATE WORKER
+
+ObjectUpdateWorker::ObjectUpdateWorker(ObjectManager* om, int index) :
+	Thread("Object Update " + String(index + 1)),
+	om(om)
+{
+}
+
+void ObjectUpdateWorker::run()
+{
+	while (!threadShouldExit())
+	{
+		if (!startEvent.wait(100)) continue;
+		if (threadShouldExit()) break;
+
+		om->processNextObjects();
+		if (--om->numBusyWorkers == 0) om->workersDoneEvent.signal();
+	}
+}
@@ -11,6 +11,8 @@
 #pragma once
 
 class ObjectManagerCustomParams;
+class BluxSequence;
+class ObjectUpdateWorker;
 
 class SubObjectManager :
 	public BaseManager<Object>
@@ -41,6 +43,11 @@ public:
 
 	BoolParameter* blackOut;
 	IntParameter* updateRate;
+	BoolParameter* multiThreadedUpdate;
+	IntParameter* updateThreads;
+	BoolParameter* onlyComputeChanges;
+	IntParameter* computedObjects;
+	IntParameter* skippedObjects;
 
 	//ui
 	IntParameter* gridThumbSize;
@@ -55,6 +62,7 @@ public:
 
 	GenericControllableManager customParams;
 	SpatManager spatializer;
+	FrameProfiler profiler;
 
 	virtual void itemAdded(GenericControllableItem*) override;
 	virtual void itemsAdded(Array<GenericControllableItem*>) override;
@@ -74,6 +82,7 @@ public:
 	void objectIDChanged(Object* o, int previousID) override;
 
 	void onContainerParameterChanged(Parameter* p) override;
+	void onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c) override;
 
 	var getSceneData();
 	void updateSceneData(var& sceneData);
@@ -83,6 +92,34 @@ public:
 
 
 	void run() override;
+	void processFrame(); //one full update : compute all objects and send to interfaces
+	Atomic<uint32> frameCount; //incremented when a frame starts, data read while sending can be released once it changed
+
+	//multithreaded update
+	OwnedArray<ObjectUpdateWorker> updateWorkers;
+	Array<Object*> objectsToProcess;
+	Array<Object*> objectsToSend;
+	Atomic<int> nextObjectIndex;
+	Atomic<int> numBusyWorkers;
+	WaitableEvent workersDoneEvent;
+
+	void updateWorkersIfNeeded();
+	void stopUpdateWorkers();
+	void computeObjectsInParallel();
+	void processNextObjects();
+
+	//change tracking
+	Atomic<bool> forceComputeAll;
+	bool forceComputeThisFrame;
+	Array<Effect*> timeDependentEffects;
+	Array<BluxSequence*> timeDependentSequences; //playing sequences, only the objects their effect layers filter are animated
+	Atomic<int> numComputedObjects;
+	Atomic<int> numSkippedObjects;
+	uint32 lastStatsUpdateTime = 0; //stats parameters are refreshed a few times per second instead of every frame
+
+	void setAllObjectsDirty();
+	void updateTimeDependencies();
+	bool isAffectedByTimeDependentEffect(Object* o);
 
 	virtual void progress(URL::DownloadTask* task, int64 downloaded, int64 total) override;
 	virtual void finished(URL::DownloadTask* task, bool success) override;
@@ -112,6 +149,19 @@ public:
 	ObjectManagerCustomParams* getCustomParams();
 };
 
+class ObjectUpdateWorker :
+	public Thread
+{
+public:
+	ObjectUpdateWorker(ObjectManager* om, int index);
+	~ObjectUpdateWorker() {}
+
+	ObjectManager* om;
+	WaitableEvent startEvent;
+
+	void run() override;
+};
+
 class ObjectManagerCustomParams :
 	public ControllableContainer,
 	public ObjectManager::ObjectManagerListener
@@ -139,6 +139,15 @@ void SceneManager::run()
 
 
 	var dataAtLoad = currentScene->getSceneData().clone();
+
+	//resolve all parameters to lerp once, then each step only sets values
+	SceneHelpers::LerpPlan lerpPlan;
+	SceneHelpers::beginLerpPlan(&lerpPlan);
+	ObjectManager::getInstance()->lerpFromSceneData(dataAtLoad.getProperty(oName, var()), currentScene->sceneData.getProperty(oName, var()), 0);
+	GroupManager::getInstance()->lerpFromSceneData(dataAtLoad.getProperty(gName, var()), currentScene->sceneData.getProperty(gName, var()), 0);
+	GlobalEffectManager::getInstance()->lerpFromSceneData(dataAtLoad.getProperty(eName, var()), currentScene->sceneData.getProperty(eName, var()), 0);
+	SceneHelpers::endLerpPlan();
+
 	double timeAtLoad = Time::getMillisecondCounter() / 1000.0;
 	if (loadTime > 0)
 	{
@@ -151,10 +160,7 @@ void SceneManager::run()
 			currentScene->loadProgress->setValue(progress);
 
 			float weight = currentScene->interpolationCurve.getValueAtPosition(progress);
-
-			ObjectManager::getInstance()->lerpFromSceneData(dataAtLoad.getProperty(oName, var()), currentScene->sceneData.getProperty(oName, var()), weight);
-			GroupManager::getInstance()->lerpFromSceneData(dataAtLoad.getProperty(gName, var()), currentScene->sceneData.getProperty(gName, var()), weight);
-			GlobalEffectManager::getInstance()->lerpFromSceneData(dataAtLoad.getProperty(eName, var()), currentScene->sceneData.getProperty(eName, var()), weight);
+			lerpPlan.lerp(weight);
 
 			sleep(30);
 		}
@@ -165,9 +171,7 @@ void SceneManager::run()
 
 	if (currentScene->loadProgress->floatValue() == 1 || loadTime == 0)
 	{
-		ObjectManager::getInstance()->lerpFromSceneData(dataAtLoad.getProperty(oName, var()), currentScene->sceneData.getProperty(oName, var()), 1);
-		GroupManager::getInstance()->lerpFromSceneData(dataAtLoad.getProperty(gName, var()), currentScene->sceneData.getProperty(gName, var()), 1);
-		GlobalEffectManager::getInstance()->lerpFromSceneData(dataAtLoad.getProperty(eName, var()), currentScene->sceneData.getProperty(eName, var()), 1);
+		lerpPlan.lerp(1);
 		currentScene->isCurrent->setValue(true);
 	}
 
@@ -201,6 +205,12 @@ Array<ChainVizTarget*> SceneManager::getChainVizTargetsForObjectAndComponent(Obj
 	return result;
 }
 
+bool SceneManager::isCrossfading()
+{
+	if (currentScene == nullptr) return false;
+	return isThreadRunning() || !currentScene->isCurrent->boolValue();
+}
+
 void SceneManager::processComponent(Object* o, ObjectComponent* c, HashMap<Parameter*, var>& values)
 {
 	if (currentScene == nullptr) return;
@@ -209,8 +219,8 @@ void SceneManager::processComponent(Object* o, ObjectComponent* c, HashMap<Param
 
 	if (previousScene != nullptr && progressWeight < 1)
 	{
-		HashMap<Parameter*, var> prevSceneValues;
-		//HashMap<Parameter*, var> newSceneValues(values.size());
+		c->syncComputedValuesFromSlots(); //the previous scene works on a copy of the table
+		HashMap<Parameter*, var> prevSceneValues(values.size() * 2 + 1);
 
 		HashMap<Parameter*, var>::Iterator copyIt(values);
 		while (copyIt.next()) prevSceneValues.set(copyIt.getKey(), copyIt.getValue().clone());
@@ -221,44 +231,39 @@ void SceneManager::processComponent(Object* o, ObjectComponent* c, HashMap<Param
 		currentScene->sequenceManager->processComponent(o, c, values);
 		currentScene->effectManager->processComponent(o, c, values);
 
-		//float invertProgress = 1 - progressWeight;
-
-		Array<Parameter*> processedParams;
+		c->syncComputedValuesFromSlots();
+		c->invalidateComputedSlots();
 
 		HashMap<Parameter*, var>::Iterator it(values);
 
 		while (it.next())
 		{
 			Parameter* cp = it.getKey();
-			var prevVal = prevSceneValues[cp];
-			var newVal = it.getValue().clone();
-			if (prevVal != newVal)
-			{
-				jassert(prevVal.size() == newVal.size());
+			const var& prevVal = prevSceneValues.getReference(cp);
+			var& newVal = values.getReference(cp);
+			if (prevVal == newVal) continue;
+
+			jassert(prevVal.size() == newVal.size());
 
-				var val;
-				if (newVal.isArray())
+			//values belong to the compute chain, lerp them in place
+			if (newVal.isArray())
+			{
+				for (int i = 0; i < newVal.size(); i++)
 				{
-					for (int i = 0; i < newVal.size(); i++)
+					var& nv = newVal.getArray()->getReference(i);
+					if (nv.isArray())
 					{
-						if (newVal[i].isArray())
-						{
-							var vv;
-							for (int j = 0; j < newVal[i].size(); j++) vv.append(jmap(progressWeight, (float)prevVal[i][j], (float)newVal[i][j]));
-							val.append(vv);
-						}
-						else
-						{
-							val.append(jmap(progressWeight, (float)prevVal[i], (float)newVal[i]));
-						}
+						for (int j = 0; j < nv.size(); j++) nv.getArray()->set(j, jmap(progressWeight, (float)prevVal[i][j], (float)nv[j]));
+					}
+					else
+					{
+						nv = jmap(progressWeight, (float)prevVal[i], (float)nv);
 					}
 				}
-				else
-				{
-					val = jmap(progressWeight, (float)prevVal, (float)newVal);
-				}
-
-				values.set(cp, val);
+			}
+			else
+			{
+				newVal = jmap(progressWeight, (float)prevVal, (float)newVal);
 			}
 		}
 	}
@@ -67,6 +67,7 @@ public:
 
 	Array<ChainVizTarget*> getChainVizTargetsForObjectAndComponent(Object* o, ComponentType t);
 	void processComponent(Object* o, ObjectComponent* c, HashMap<Parameter*, var>& values);
+	bool isCrossfading(); //all objects are lerped while crossfading, scene sequences are tracked by the ObjectManager
 
 	void onContainerTriggerTriggered(Trigger* t) override;
 	void onContainerParameterChanged(Parameter* p) override;
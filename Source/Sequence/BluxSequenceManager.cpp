@@ -46,6 +46,15 @@ void BluxSequenceManager::processRawData()
 	}
 }
 
+bool BluxSequenceManager::isPlaying()
+{
+	for (auto& i : items)
+	{
+		if (i->enabled->boolValue() && i->isPlaying->boolValue()) return true;
+	}
+	return false;
+}
+
 Array<ChainVizTarget*> BluxSequenceManager::getChainVizTargetsForObjectAndComponent(Object* o, ComponentType c)
 {
 	Array<ChainVizTarget*> result;
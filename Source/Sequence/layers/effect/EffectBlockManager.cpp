@@ -14,7 +14,8 @@
 juce_ImplementSingleton(EffectBlockFactory)
 
 EffectBlockManager::EffectBlockManager(EffectLayer * layer) :
-    LayerBlockManager(layer, "Blocks")
+    LayerBlockManager(layer, "Blocks"),
+    intervalsVersion(-1)
 {
     managerFactory = EffectBlockFactory::getInstance();
 }
@@ -33,6 +34,7 @@ void EffectBlockManager::addItemInternal(LayerBlock* block, var data)
 	LayerBlockManager::addItemInternal(block, data);
 	EffectBlock * clip = dynamic_cast<EffectBlock *>(block);
 	clip->addEffectBlockListener(this);
+	invalidateIntervals();
 }
 
 void EffectBlockManager::addItemsInternal(Array<LayerBlock*> blocks, var data)
@@ -43,6 +45,7 @@ void EffectBlockManager::addItemsInternal(Array<LayerBlock*> blocks, var data)
 		EffectBlock * clip = dynamic_cast<EffectBlock *>(b);
 		clip->addEffectBlockListener(this);
 	}
+	invalidateIntervals();
 }
 
 void EffectBlockManager::removeItemInternal(LayerBlock* block)
@@ -50,6 +53,7 @@ void EffectBlockManager::removeItemInternal(LayerBlock* block)
 	LayerBlockManager::removeItemInternal(block);
 	EffectBlock * clip = dynamic_cast<EffectBlock *>(block);
 	clip->removeEffectBlockListener(this);
+	invalidateIntervals();
 }
 
 void EffectBlockManager::removeItemsInternal(Array<LayerBlock*> blocks)
@@ -60,6 +64,7 @@ void EffectBlockManager::removeItemsInternal(Array<LayerBlock*> blocks)
 		EffectBlock * clip = dynamic_cast<EffectBlock *>(b);
 		clip->removeEffectBlockListener(this);
 	}
+	invalidateIntervals();
 }
 
 void EffectBlockManager::onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c)
@@ -69,12 +74,66 @@ void EffectBlockManager::onControllableFeedbackUpdate(ControllableContainer* cc,
 	{
 		if (c == b->time || c == b->coreLength || c == b->loopLength)
 		{
+			invalidateIntervals();
 			if (!blocksCanOverlap) return;
 			computeFadesForBlock(b, true);
 		}
 	}
 }
 
+void EffectBlockManager::invalidateIntervals()
+{
+	++blocksVersion;
+}
+
+void EffectBlockManager::getBlocksInTimeRange(float start, float end, Array<LayerBlock*>& result)
+{
+	GenericScopedLock lock(intervalLock);
+
+	int version = blocksVersion.get();
+	if (intervalsVersion != version)
+	{
+		rebuildIntervals();
+		intervalsVersion = version;
+	}
+
+	collectBlocksInTimeRange(0, intervals.size(), start, end, result);
+}
+
+void EffectBlockManager::rebuildIntervals()
+{
+	intervals.clearQuick();
+	for (auto& b : items) intervals.add({ b->time->floatValue(), b->getEndTime(), 0, b });
+	std::sort(intervals.begin(), intervals.end(), [](const BlockInterval& a, const BlockInterval& b) { return a.start < b.start; });
+	computeMaxEnd(0, intervals.size());
+}
+
+float EffectBlockManager::computeMaxEnd(int lo, int hi)
+{
+	if (lo >= hi) return std::numeric_limits<float>::lowest();
+
+	int mid = (lo + hi) / 2;
+	BlockInterval& node = intervals.getReference(mid);
+	node.maxEnd = jmax(node.end, computeMaxEnd(lo, mid), computeMaxEnd(mid + 1, hi));
+	return node.maxEnd;
+}
+
+void EffectBlockManager::collectBlocksInTimeRange(int lo, int hi, float start, float end, Array<LayerBlock*>& result)
+{
+	if (lo >= hi) return;
+
+	int mid = (lo + hi) / 2;
+	const BlockInterval& node = intervals.getReference(mid);
+	if (node.maxEnd < start) return; //nothing in this subtree reaches the range
+
+	collectBlocksInTimeRange(lo, mid, start, end, result);
+
+	if (node.start > end) return; //everything on the right starts after the range
+	if (node.end >= start) result.add(node.block);
+
+	collectBlocksInTimeRange(mid + 1, hi, start, end, result);
+}
+
 
 void EffectBlockManager::effectBlockFadesChanged(EffectBlock* block)
 {
@@ -39,6 +39,27 @@ public:
 
     void onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c) override;
 
+    //Interval index over block time ranges : blocks sorted by start time, read as an implicit balanced tree
+    //where each node keeps the max end time of its subtree. Rebuilt lazily when blocks are added, removed, moved or resized
+    struct BlockInterval
+    {
+        float start;
+        float end;
+        float maxEnd;
+        LayerBlock* block;
+    };
+
+    Array<BlockInterval> intervals;
+    CriticalSection intervalLock;
+    Atomic<int> blocksVersion;
+    int intervalsVersion;
+
+    void invalidateIntervals();
+    void getBlocksInTimeRange(float start, float end, Array<LayerBlock*>& result);
+    void rebuildIntervals();
+    float computeMaxEnd(int lo, int hi);
+    void collectBlocksInTimeRange(int lo, int hi, float start, float end, Array<LayerBlock*>& result);
+
     void effectBlockFadesChanged(EffectBlock * block) override;
     void computeFadesForBlock(EffectBlock * block, bool propagate);
 };
\ No newline at end of file
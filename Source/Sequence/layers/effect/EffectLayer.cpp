@@ -12,6 +12,72 @@
 #include "Sequence/SequenceIncludes.h"
 #include "Effect/EffectIncludes.h"
 
+namespace BlockAccumulator
+{
+	//per thread and reused across frames, so blending overlapping blocks of the same component doesn't allocate once warmed up
+	thread_local HashMap<Parameter*, var> scratch;
+	thread_local HashMap<Parameter*, var> sum;
+	thread_local Array<Parameter*> staleKeys;
+
+	//blocks iterate the map they process, so it must hold exactly the keys of the computed values
+	void matchKeys(HashMap<Parameter*, var>& map, const HashMap<Parameter*, var>& values)
+	{
+		staleKeys.clearQuick();
+		for (HashMap<Parameter*, var>::Iterator it(map); it.next();)
+		{
+			if (!values.contains(it.getKey())) staleKeys.add(it.getKey());
+		}
+
+		for (auto& k : staleKeys) map.remove(k);
+	}
+
+	//arrays are deep copied the first time, then only their elements are assigned
+	void copyInPlace(var& target, const var& source)
+	{
+		if (!source.isArray())
+		{
+			target = source;
+			return;
+		}
+
+		if (!target.isArray() || target.size() != source.size()) target = source.clone();
+		Array<var>* ta = target.getArray();
+		for (int i = 0; i < source.size(); i++) copyInPlace(ta->getReference(i), source[i]);
+	}
+
+	void accumulate(var& acc, const var& value, float weight, bool first)
+	{
+		if (!value.isArray())
+		{
+			acc = first ? (float)value * weight : (float)acc + (float)value * weight;
+			return;
+		}
+
+		if (!acc.isArray() || acc.size() != value.size())
+		{
+			acc = value.clone();
+			first = true;
+		}
+
+		Array<var>* aa = acc.getArray();
+		for (int i = 0; i < value.size(); i++) accumulate(aa->getReference(i), value[i], weight, first);
+	}
+
+	//values are owned by the computing chain, the result is written into them instead of sharing the accumulator arrays
+	void resolve(var& target, const var& acc, float multiplier)
+	{
+		if (!acc.isArray())
+		{
+			target = (float)acc * multiplier;
+			return;
+		}
+
+		if (!target.isArray() || target.size() != acc.size()) target = acc.clone();
+		Array<var>* ta = target.getArray();
+		for (int i = 0; i < acc.size(); i++) resolve(ta->getReference(i), acc[i], multiplier);
+	}
+}
+
 EffectLayer::EffectLayer(Sequence* s, var params) :
 	SequenceLayer(s, "Effect"),
 	blockManager(this)
@@ -58,102 +124,101 @@ void EffectLayer::processComponent(Object* o, ObjectComponent* c, HashMap<Parame
 	if (fr.id == -1) return;
 
 	float time = sequence->currentTime->floatValue() - timeOffsetByID->floatValue() * fr.id;
-	Array<LayerBlock*> blocks = blockManager.getBlocksAtTime(time, false);
+	ActiveBlockSet::Ptr active = getActiveBlocks(time);
 
-	if (blocks.isEmpty()) return;
+	EffectBlock* firstBlock = nullptr;
+	Array<EffectBlock*> blocks; //only filled when blocks overlap at this time
+	for (auto& b : active->blocks)
+	{
+		if (!b->enabled->boolValue() || time < b->time->floatValue() || time > b->getEndTime()) continue;
+		if (firstBlock == nullptr) firstBlock = b;
+		else
+		{
+			if (blocks.isEmpty()) blocks.add(firstBlock);
+			blocks.add(b);
+		}
+	}
 
-	if (blocks.size() == 1) {
-		EffectBlock* eb = (EffectBlock*)blocks[0];
-		eb->processComponent(o, c, values, fr.weight * weightMultiplier, fr.id, time);
+	if (firstBlock == nullptr) return;
+
+	if (blocks.isEmpty()) {
+		firstBlock->processComponent(o, c, values, fr.weight * weightMultiplier, fr.id, time);
 		return;
 	}
 
-	//lerp
-	HashMap<Parameter*, var>::Iterator valIt(values);
+	//overlapping blocks : each block is processed from the same input values into a reused scratch map,
+	//then its output is accumulated weighted by its fade, so no map is copied per block
+	c->syncComputedValuesFromSlots(); //blocks work on a copy of the table
+	c->invalidateComputedSlots();
 
-	OwnedArray<HashMap<Parameter*, var>> blockMaps;
-	Array<float> blockWeights;
+	HashMap<Parameter*, var>& scratch = BlockAccumulator::scratch;
+	HashMap<Parameter*, var>& sum = BlockAccumulator::sum;
+	BlockAccumulator::matchKeys(scratch, values);
+	BlockAccumulator::matchKeys(sum, values);
+
+	HashMap<Parameter*, var>::Iterator valIt(values);
+	float totalWeight = 0;
 
 	for (auto& b : blocks)
 	{
-		HashMap<Parameter*, var>* bVals = new HashMap<Parameter*, var>();
+		float fadeWeight = jmax(b->getFadeMultiplier(time), 0.f);
+		if (fadeWeight == 0) continue;
+
 		valIt.reset();
-		while (valIt.next()) bVals->set(valIt.getKey(), valIt.getValue().clone());
-		((EffectBlock*)b)->processComponent(o, c, *bVals, fr.weight * weightMultiplier, fr.id, time, true);
-		blockMaps.add(bVals);
-		blockWeights.add(((EffectBlock*)b)->getFadeMultiplier(time));
-	}
+		while (valIt.next()) BlockAccumulator::copyInPlace(scratch.getReference(valIt.getKey()), valIt.getValue());
 
+		b->processComponent(o, c, scratch, fr.weight * weightMultiplier, fr.id, time, true);
 
-	//lerp between all now
+		valIt.reset();
+		while (valIt.next()) BlockAccumulator::accumulate(sum.getReference(valIt.getKey()), scratch.getReference(valIt.getKey()), fadeWeight, totalWeight == 0);
+		totalWeight += fadeWeight;
+	}
 
-	valIt.reset();
-	while (valIt.next())
-	{
-		Parameter* cp = valIt.getKey();
-		Array<var> blockVals;
-		bool sameVal = true;
-		var firstVal = blockMaps.getFirst()->getReference(cp);
-		for (auto& b : blockMaps)
-		{
-			var v = b->getReference(cp);
-			jassert(v.size() == firstVal.size());
-			if (v != firstVal) sameVal = false;
-			blockVals.add(v);
-		}
+	if (totalWeight == 0) return; //all blocks are faded out at this time
 
-		if (sameVal)
-		{
-			DBG("Same val, not lerping");
-			values.set(cp, firstVal);
-			continue;
-		}
+	valIt.reset();
+	while (valIt.next()) BlockAccumulator::resolve(values.getReference(valIt.getKey()), sum.getReference(valIt.getKey()), 1.f / totalWeight);
+}
 
-		DBG("Different values, lerping");
+EffectLayer::ActiveBlockSet::Ptr EffectLayer::getActiveBlocks(float time)
+{
+	float frameTime = sequence->currentTime->floatValue();
+	int version = blockManager.blocksVersion.get(); //read before querying, a change during the query triggers another one
 
-		var averageVal = getAverageValue(blockVals, blockWeights);
-		values.set(cp, averageVal);
+	ActiveBlockSet::Ptr set;
+	{
+		SpinLock::ScopedLockType lock(activeBlocksLock);
+		set = activeBlocks;
 	}
 
-	//for (auto& b : blocks) ((EffectBlock*)b)->processComponent(o, c, values, fr.weight * weightMultiplier, fr.id, time);
-}
+	bool sameFrame = set != nullptr && set->version == version && set->frameTime == frameTime;
+	if (sameFrame && time >= set->start && time <= set->end) return set;
 
-var EffectLayer::getAverageValue(Array<var> values, Array<float> weights)
-{
-	if (values.isEmpty()) return 0;
-
-	bool valuesAreArrays = values[0].isArray();
+	float spreadTime = frameTime - timeOffsetByID->floatValue() * ObjectManager::getInstance()->items.size();
 
-	if (!valuesAreArrays)
+	ActiveBlockSet::Ptr newSet = new ActiveBlockSet();
+	newSet->frameTime = frameTime;
+	newSet->version = version;
+	newSet->start = jmin(time, frameTime, spreadTime);
+	newSet->end = jmax(time, frameTime, spreadTime);
+	if (sameFrame)
 	{
-		float totalValue = 0;
-		float totalWeight = 0;
-		for (int i = 0; i < values.size(); i++)
-		{
-			totalValue += (float)values[i] * weights[i];
-			totalWeight += weights[i];
-		}
-
-		if (totalWeight == 0) return 0;
-		return totalValue / totalWeight;
+		newSet->start = jmin(newSet->start, set->start);
+		newSet->end = jmax(newSet->end, set->end);
 	}
 
-	//values are arrays
-	//recurse
+	Array<LayerBlock*> blocks;
+	blockManager.getBlocksInTimeRange(newSet->start, newSet->end, blocks);
+	for (auto& b : blocks) newSet->blocks.add((EffectBlock*)b);
 
-	var result;
-	for (int vi = 0; vi < values[0].size(); vi++)
 	{
-		Array<var> subValues;
-		for (int i = 0; i < values.size(); i++) subValues.add(values[i][vi]);
-		var v = getAverageValue(subValues, weights);
-		result.append(v);
+		SpinLock::ScopedLockType lock(activeBlocksLock);
+		activeBlocks = newSet;
 	}
 
-	return result;
+	return newSet;
 }
 
-
 SequenceLayerTimeline* EffectLayer::getTimelineUI()
 {
 	return new EffectLayerTimeline(this);
@@ -26,13 +26,28 @@ public:
 
 	FloatParameter* timeOffsetByID;
 
-	Array<EffectBlock*, CriticalSection> activeBlocks;
+	//Blocks around the current time, queried from the block index once per frame and shared by all objects.
+	//With an offset by ID, the window covers the times of all objects
+	struct ActiveBlockSet :
+		public ReferenceCountedObject
+	{
+		float frameTime = 0;
+		float start = 0;
+		float end = 0;
+		int version = -1;
+		Array<EffectBlock*> blocks;
+
+		typedef ReferenceCountedObjectPtr<ActiveBlockSet> Ptr;
+	};
+
+	SpinLock activeBlocksLock;
+	ActiveBlockSet::Ptr activeBlocks;
+
+	ActiveBlockSet::Ptr getActiveBlocks(float time);
 
 	Array<ChainVizTarget*> getChainVizTargetsForObjectAndComponent(Object* o, ComponentType t);
 	virtual void processComponent(Object* o, ObjectComponent* c, HashMap<Parameter*, var>& values, float weightMultiplier = 1.0f);
 
-	var getAverageValue(Array<var> values, Array<float> weights);
-
 	SequenceLayerTimeline* getTimelineUI() override;
 
 	String getTypeString() const override { return "Effect"; }
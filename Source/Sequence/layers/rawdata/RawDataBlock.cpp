@@ -12,7 +12,8 @@
 
 RawDataBlock::RawDataBlock() :
 	LayerBlock(getTypeString()),
-	lastReadFrameIndex(0),
+	fileData(nullptr),
+	fileSize(0),
 	rawDataNotifier(5)
 {
 	blendMode = addEnumParameter("Blend Mode", "Data blending");
@@ -53,145 +54,306 @@ inline void RawDataBlock::controllableStateChanged(Controllable* c)
 	}
 }
 
+static float readRawFloat(const uint8* d)
+{
+	uint32 v = ByteOrder::littleEndianInt(d);
+	float f;
+	memcpy(&f, &v, sizeof(float));
+	return f;
+}
+
 void RawDataBlock::readInfos()
 {
-	universeFrameMap.clear();
-	universeFrameMap.set(-1, Array<FrameData*>());
 	frames.clear();
-	fs.reset();
+	frameEntries.clear();
+	trackMap.clear();
+	tracks.clear();
+	mappedFile.reset();
+	fileData = nullptr;
+	fileSize = 0;
 
 	if (!file.existsAsFile()) return;
 
-	fs.reset(new FileInputStream(file));
+	mappedFile.reset(new MemoryMappedFile(file, MemoryMappedFile::readOnly));
+	if (mappedFile->getData() == nullptr || mappedFile->getSize() < 12)
+	{
+		LOGERROR("Could not open raw data file " << file.getFullPathName());
+		mappedFile.reset();
+		return;
+	}
+
+	fileData = (const uint8*)mappedFile->getData();
+	fileSize = (int64)mappedFile->getSize();
+
+	float totalTime = 0;
+	bool isV2 = (int)ByteOrder::littleEndianInt(fileData) == RAW_DATA_MAGIC;
 
-	float totalTime = fs->readFloat();
-	int numUniverses = fs->readInt();
-	int numWrittenFrames = fs->readInt();
+	if (isV2)
+	{
+		int version = (int)ByteOrder::littleEndianInt(fileData + 4);
+		if (version > RAW_DATA_VERSION) LOGWARNING("Raw data file was recorded with a newer version (" << version << "), it may not be read correctly");
+		if (!readIndex(totalTime))
+		{
+			LOGWARNING("Raw data file has no valid index, it may not have been closed properly. Reading all frames instead.");
+			readFramesV2(totalTime);
+		}
+	}
+	else
+	{
+		readLegacyFrames(totalTime);
+	}
 
-	LOG("Read data, total time : " << totalTime << ", num universes : " << numUniverses << ", num written frames : " << numWrittenFrames);
+	LOG("Read data, total time : " << totalTime << ", num universes : " << tracks.size() << ", num frames : " << frames.size());
 	if (!isCurrentlyLoadingData && !Engine::mainEngine->isLoadingFile) setNiceName(file.getFileNameWithoutExtension());
 
-	while (fs->getNumBytesRemaining() > 0)
+	if(!coreLength->isOverriden) coreLength->setDefaultValue(totalTime, true);
+}
+
+bool RawDataBlock::readIndex(float& totalTime)
+{
+	//header : magic, version, totalTime, numUniverses, numFrames
+	//footer : index..., indexPos (int64), numFrames, magic
+	const int headerSize = 20;
+	const int footerSize = 16;
+	if (fileSize < headerSize + footerSize) return false;
+
+	const uint8* footer = fileData + fileSize - footerSize;
+	if ((int)ByteOrder::littleEndianInt(footer + 12) != RAW_DATA_MAGIC) return false;
+
+	int64 indexPos = (int64)ByteOrder::littleEndianInt64(footer);
+	int numFrames = (int)ByteOrder::littleEndianInt(footer + 8);
+	if (indexPos < headerSize || indexPos > fileSize - footerSize || numFrames < 0) return false;
+
+	totalTime = readRawFloat(fileData + 8);
+
+	//index : for each frame, time, numUniverses, then for each universe, universe index, data position (int64) and data type
+	const uint8* d = fileData + indexPos;
+	const uint8* end = footer;
+
+	frames.ensureStorageAllocated((int)jmin<int64>(numFrames, (fileSize - indexPos) / 8));
+
+	for (int i = 0; i < numFrames; i++)
 	{
-		int frameSize = fs->readInt();
-		float frameTime = fs->readFloat();
-		int numUniverses = fs->readInt();
-		int dataPos = fs->getPosition();
+		if (d + 8 > end) return false;
 
-		FrameData* frame = new FrameData(frameTime, numUniverses, dataPos);
+		FrameData frame{ readRawFloat(d), frameEntries.size(), 0 };
+		int numUniverses = (int)ByteOrder::littleEndianInt(d + 4);
+		d += 8;
 
-		for (int i = 0; i < numUniverses; i++)
+		if (d + (int64)numUniverses * 13 > end) return false;
+
+		for (int u = 0; u < numUniverses; u++)
 		{
-			int univ = fs->readInt();
+			int universeIndex = (int)ByteOrder::littleEndianInt(d);
+			int64 dataPos = (int64)ByteOrder::littleEndianInt64(d + 4);
+			bool isDelta = d[12] == DELTA_DATA;
+			d += 13;
+
+			if (dataPos < headerSize || dataPos >= indexPos) return false;
+			addUniverseFrame(frame, universeIndex, dataPos, isDelta);
+		}
 
-			frame->universePosMap.set(univ, fs->getPosition());
+		frames.add(frame);
+	}
+
+	return true;
+}
 
-			if (!universeFrameMap.contains(univ)) universeFrameMap.set(univ, Array<FrameData*>());
-			universeFrameMap.getReference(univ).add(frame);
+bool RawDataBlock::readFramesV2(float& totalTime)
+{
+	//fallback when the index is missing, frames are self-described
+	frames.clear();
+	frameEntries.clear();
+	trackMap.clear();
+	tracks.clear();
 
-			recordedUniverseIndices.addIfNotAlreadyThere(univ);
+	int64 pos = 20;
+	while (pos + 8 <= fileSize)
+	{
+		FrameData frame{ readRawFloat(fileData + pos), frameEntries.size(), 0 };
+		int numUniverses = (int)ByteOrder::littleEndianInt(fileData + pos + 4);
+		pos += 8;
 
-			fs->setPosition(fs->getPosition() + DMX_NUM_CHANNELS);
+		for (int u = 0; u < numUniverses; u++)
+		{
+			if (pos + 5 > fileSize) return false;
+			int universeIndex = (int)ByteOrder::littleEndianInt(fileData + pos);
+			bool isDelta = fileData[pos + 4] == DELTA_DATA;
+			pos += 5;
+
+			int64 dataSize = DMX_NUM_CHANNELS;
+			if (isDelta)
+			{
+				if (pos + 2 > fileSize) return false;
+				dataSize = 2 + ByteOrder::littleEndianShort(fileData + pos) * 3;
+			}
+
+			if (pos + dataSize > fileSize) return false;
+			addUniverseFrame(frame, universeIndex, pos, isDelta);
+			pos += dataSize;
 		}
 
 		frames.add(frame);
-		universeFrameMap.getReference(-1).add(frame);
-
-		fs->setPosition(dataPos + frameSize);
+		totalTime = frame.time;
 	}
 
-	LOG("Check, num stored frames " << frames.size());
-
-	if(!coreLength->isOverriden) coreLength->setDefaultValue(totalTime, true);
+	return true;
 }
 
-Array<DMXUniverse*> RawDataBlock::readFrameAtTime(float time)
+bool RawDataBlock::readLegacyFrames(float& totalTime)
 {
-	Array<DMXUniverse*> result;
+	//header : totalTime, numUniverses, numWrittenFrames, then for each frame : frameSize, time, numUniverses, and full universes
+	totalTime = readRawFloat(fileData);
 
-	if (fs == nullptr) return result;
+	int64 pos = 12;
+	while (pos + 12 <= fileSize)
+	{
+		int frameSize = (int)ByteOrder::littleEndianInt(fileData + pos);
+		FrameData frame{ readRawFloat(fileData + pos + 4), frameEntries.size(), 0 };
+		int numUniverses = (int)ByteOrder::littleEndianInt(fileData + pos + 8);
+		int64 dataPos = pos + 12;
 
-	FrameData* f = getFrameDataAtTime(time);
-	if (f == nullptr) return result;
+		if (frameSize < 0 || dataPos + frameSize > fileSize) return false;
 
-	fs->setPosition(f->filePos);
-	for (int i = 0; i < f->numUniverses; i++)
-	{
-		int universeIndex = fs->readInt();
-		DMXUniverse* u = new DMXUniverse(universeIndex);
-		fs->read(u->values.getRawDataPointer(), DMX_NUM_CHANNELS);
-		result.add(u);
+		for (int u = 0; u < numUniverses; u++)
+		{
+			int64 uPos = dataPos + (int64)u * (4 + DMX_NUM_CHANNELS);
+			if (uPos + 4 + DMX_NUM_CHANNELS > dataPos + frameSize) break;
+			addUniverseFrame(frame, (int)ByteOrder::littleEndianInt(fileData + uPos), uPos + 4, false);
+		}
+
+		frames.add(frame);
+		pos = dataPos + frameSize;
 	}
 
-	return result;
+	return true;
 }
 
-Array<DMXUniverse*> RawDataBlock::readAllUniversesAtTime(float time)
+void RawDataBlock::addUniverseFrame(FrameData& frame, int universeIndex, int64 dataPos, bool isDelta)
 {
-	Array<DMXUniverse*> result;
-
-	for (auto& univ : recordedUniverseIndices)
+	UniverseTrack* t = trackMap[universeIndex];
+	if (t == nullptr)
 	{
-		DMXUniverse* u = readUniverseAtTime(time, univ);
-		if (u == nullptr) continue;
-		result.add(u);
+		t = tracks.add(new UniverseTrack(universeIndex));
+		trackMap.set(universeIndex, t);
 	}
 
-	return result;
+	int index = t->frames.size();
+	int keyFrameIndex = isDelta && index > 0 ? t->frames.getReference(index - 1).keyFrameIndex : index;
+	t->frames.add({ frame.time, dataPos, keyFrameIndex, isDelta });
+
+	frameEntries.add({ t, index });
+	frame.numUniverses++;
 }
 
-DMXUniverse* RawDataBlock::readUniverseAtTime(float time, int universeIndex)
+int RawDataBlock::readFrameAtTime(float time, OwnedArray<DMXUniverse, CriticalSection>& target)
 {
-	FrameData* f = getFrameDataAtTime(time, universeIndex);
-	if (f == nullptr) return nullptr;
+	if (fileData == nullptr) return 0;
 
-	fs->setPosition(f->universePosMap[universeIndex]);
+	FrameData* f = getFrameDataAtTime(time);
+	if (f == nullptr) return 0;
 
-	DMXUniverse* u = new DMXUniverse(universeIndex);
-	fs->read(u->values.getRawDataPointer(), DMX_NUM_CHANNELS);
+	for (int i = 0; i < f->numUniverses; i++)
+	{
+		const FrameEntry& e = frameEntries.getReference(f->firstEntry + i);
+		fillUniverseSlot(target, i, e.track->universeIndex, decodeTrack(e.track, e.trackFrameIndex));
+	}
 
-	return u;
+	return f->numUniverses;
 }
 
+int RawDataBlock::readAllUniversesAtTime(float time, OwnedArray<DMXUniverse, CriticalSection>& target)
+{
+	if (fileData == nullptr) return 0;
+
+	int numFilled = 0;
+	for (auto& t : tracks)
+	{
+		int frameIndex = getTrackFrameIndexAtTime(t, time);
+		if (frameIndex < 0) continue;
+		fillUniverseSlot(target, numFilled++, t->universeIndex, decodeTrack(t, frameIndex));
+	}
+
+	return numFilled;
+}
 
-RawDataBlock::FrameData* RawDataBlock::getFrameDataAtTime(float time, int universeIndex)
+const uint8* RawDataBlock::decodeTrack(UniverseTrack* t, int frameIndex)
 {
-	float t = getRelativeTime(time, true);
-	if (time < 0) return nullptr;
+	uint8* values = t->values.getRawDataPointer();
+	if (t->decodedFrameIndex == frameIndex) return values;
+
+	const UniverseFrame& target = t->frames.getReference(frameIndex);
 
-	Array<FrameData*> univFrames = universeFrameMap.getReference(universeIndex); //-1 holds all the frames
+	//continue from the last decoded frame if it's in the same chain of deltas, otherwise restart from the key frame
+	int startIndex = target.keyFrameIndex;
+	if (t->decodedFrameIndex >= target.keyFrameIndex && t->decodedFrameIndex < frameIndex) startIndex = t->decodedFrameIndex + 1;
+	else if (t->frames.getReference(startIndex).isDelta) zeromem(values, DMX_NUM_CHANNELS);
 
-	if (univFrames.size() == 0) return nullptr;
-	if (univFrames.size() == 1) return univFrames[0];
+	const uint8* end = fileData + fileSize;
 
-	int frameIndex = jlimit(0, univFrames.size() - 1, lastReadFrameIndex + 1);
-	if (univFrames[frameIndex] != nullptr && univFrames[frameIndex]->time < t)
+	for (int i = startIndex; i <= frameIndex; i++)
 	{
-		while (univFrames[frameIndex]->time <= t && frameIndex < univFrames.size() - 1)
+		const UniverseFrame& f = t->frames.getReference(i);
+		const uint8* d = fileData + f.dataPos;
+
+		if (!f.isDelta)
 		{
-			frameIndex++;
+			if (d + DMX_NUM_CHANNELS <= end) memcpy(values, d, DMX_NUM_CHANNELS);
+			continue;
 		}
 
+		if (d + 2 > end) continue;
+		int numChanges = ByteOrder::littleEndianShort(d);
+		d += 2;
+		for (int c = 0; c < numChanges && d + 3 <= end; c++, d += 3)
+		{
+			int channel = ByteOrder::littleEndianShort(d);
+			if (channel < DMX_NUM_CHANNELS) values[channel] = d[2];
+		}
 	}
 
-	if (univFrames[frameIndex] != nullptr && univFrames[frameIndex]->time > t)
+	t->decodedFrameIndex = frameIndex;
+	return values;
+}
+
+void RawDataBlock::fillUniverseSlot(OwnedArray<DMXUniverse, CriticalSection>& target, int slot, int universeIndex, const uint8* values)
+{
+	DMXUniverse* u = target[slot];
+	if (u == nullptr || u->getUniverseIndex() != universeIndex)
 	{
-		while (univFrames[frameIndex]->time > t && frameIndex > 0)
-		{
-			frameIndex--;
-		}
+		u = new DMXUniverse(universeIndex);
+		if (slot < target.size()) target.set(slot, u, true);
+		else target.add(u);
 	}
 
-	if (frameIndex < 0) return nullptr;
+	memcpy(u->values.getRawDataPointer(), values, DMX_NUM_CHANNELS);
+}
+
 
-	return univFrames[frameIndex];
+RawDataBlock::FrameData* RawDataBlock::getFrameDataAtTime(float time)
+{
+	float t = getRelativeTime(time, true);
+	if (time < 0 || frames.isEmpty()) return nullptr;
+
+	//last frame at or before t, or the first one if t is before all frames
+	auto it = std::upper_bound(frames.begin(), frames.end(), t, [](float t, const FrameData& f) { return t < f.time; });
+	int index = jmax<int>(0, (int)(it - frames.begin()) - 1);
+	return &frames.getReference(index);
+}
+
+int RawDataBlock::getTrackFrameIndexAtTime(UniverseTrack* track, float time)
+{
+	float t = getRelativeTime(time, true);
+	if (time < 0 || track->frames.isEmpty()) return -1;
+
+	auto it = std::upper_bound(track->frames.begin(), track->frames.end(), t, [](float t, const UniverseFrame& f) { return t < f.time; });
+	return jmax<int>(0, (int)(it - track->frames.begin()) - 1);
 }
 
 float RawDataBlock::getLastFrameTime()
 {
-	FrameData* f = frames.getLast();
-	if (f == nullptr) return 0;
-	return f->time;
+	if (frames.isEmpty()) return 0;
+	return frames.getLast().time;
 }
 
 float RawDataBlock::getFadeFactorAtTime(float t)
@@ -25,32 +25,71 @@ public:
 
 	enum BlendMode { ALPHA, ADD, MULTIPLY, MAX, MIN };
 	EnumParameter* blendMode;
-	std::unique_ptr<FileInputStream> fs;
 
-	struct FrameData
+	//file format. Version 2 files start with the magic and version and end with an index of all frames, so they can be opened without scanning.
+	//Universes are stored either full or as a delta from their previous frame, with a full frame at least every RAW_DATA_KEYFRAME_INTERVAL frames.
+	//Files without the magic are legacy recordings, with a size-prefixed sequence of full frames.
+	enum { RAW_DATA_MAGIC = 0x44525842, RAW_DATA_VERSION = 2, RAW_DATA_KEYFRAME_INTERVAL = 64 };
+	enum UniverseDataType { FULL_DATA = 0, DELTA_DATA = 1 };
+
+	std::unique_ptr<MemoryMappedFile> mappedFile;
+	const uint8* fileData;
+	int64 fileSize;
+
+	struct UniverseFrame
 	{
-		FrameData(float time, float numUniverses, float filePos) : time(time), numUniverses(numUniverses), filePos(filePos) {}
-		float time = -1;
-		int numUniverses = 0;
-		int filePos = 0;
-		HashMap<int, int> universePosMap;
+		float time;
+		int64 dataPos;
+		int keyFrameIndex; //index of the full frame this one builds upon, itself if full
+		bool isDelta;
 	};
 
-	OwnedArray<FrameData> frames;
-	HashMap<int, Array<FrameData*>> universeFrameMap;
-	Array<int> recordedUniverseIndices;;
+	struct UniverseTrack
+	{
+		UniverseTrack(int universeIndex) : universeIndex(universeIndex), decodedFrameIndex(-1) { values.insertMultiple(0, 0, DMX_NUM_CHANNELS); }
+		int universeIndex;
+		Array<UniverseFrame> frames;
+
+		Array<uint8> values; //last decoded values, so sequential playback only applies one delta per frame
+		int decodedFrameIndex;
+	};
 
-	int lastReadFrameIndex;
+	struct FrameEntry
+	{
+		UniverseTrack* track;
+		int trackFrameIndex;
+	};
+
+	struct FrameData
+	{
+		float time;
+		int firstEntry;
+		int numUniverses;
+	};
+
+	Array<FrameData> frames;
+	Array<FrameEntry> frameEntries;
+	OwnedArray<UniverseTrack> tracks;
+	HashMap<int, UniverseTrack*> trackMap;
 
 	void onContainerParameterChangedInternal(Parameter* p) override;
 	void controllableStateChanged(Controllable* c);
 
 	void readInfos();
-	Array<DMXUniverse*> readFrameAtTime(float time);
-	Array<DMXUniverse*> readAllUniversesAtTime(float time);
-	DMXUniverse* readUniverseAtTime(float time, int universeIndex);
+	bool readIndex(float& totalTime);
+	bool readFramesV2(float& totalTime);
+	bool readLegacyFrames(float& totalTime);
+	void addUniverseFrame(FrameData& frame, int universeIndex, int64 dataPos, bool isDelta);
+
+	//universes are filled in target, reusing the ones already there. Returns the number of universes filled
+	int readFrameAtTime(float time, OwnedArray<DMXUniverse, CriticalSection>& target);
+	int readAllUniversesAtTime(float time, OwnedArray<DMXUniverse, CriticalSection>& target);
+
+	const uint8* decodeTrack(UniverseTrack* t, int frameIndex);
+	static void fillUniverseSlot(OwnedArray<DMXUniverse, CriticalSection>& target, int slot, int universeIndex, const uint8* values);
 
-	FrameData* getFrameDataAtTime(float time, int universeIndex = -1);
+	FrameData* getFrameDataAtTime(float time);
+	int getTrackFrameIndexAtTime(UniverseTrack* t, float time);
 	
 	float getLastFrameTime();
 
@@ -16,6 +16,7 @@ RawDataLayer::RawDataLayer(Sequence* s, var params) :
 	blockManager(this),
 	timeAtRecord(0),
 	numWrittenFrames(0),
+	numFrameUniverses(0),
 	activeBlock(nullptr),
 	needsToSendAllUniverses(true),
 	dmxInterface(nullptr)
@@ -29,6 +30,7 @@ RawDataLayer::RawDataLayer(Sequence* s, var params) :
 	targetInterface->typesFilter.add(DMXInterface::getTypeStringStatic());
 
 	forceResetValues = addBoolParameter("Force Reset Values", "If checked, this will force a value to zero before resetting", false);
+	compressRecording = addBoolParameter("Compress Recording", "If checked, only the channels that changed since the previous frame are recorded, with a full universe written regularly to keep seeking fast", true);
 
 	arm = addBoolParameter("arm", "arm", false);
 	autoDisarm = addBoolParameter("autoDisarm", "autoDisarm", true);
@@ -80,14 +82,19 @@ void RawDataLayer::startRecording()
 	//reset universes
 	universeIdMap.clear();
 	universes.clear();
+	recordedUniverses.clear();
+	framesSinceKeyFrame.clear();
+	recordIndex.reset();
 
 	recordingFile = recordToSave->getFile();
 	if (recordingFile.existsAsFile()) recordingFile.deleteFile();
 
 	output.reset(new FileOutputStream(recordingFile));
 
-	//reserve space for metadata
+	output->writeInt(RawDataBlock::RAW_DATA_MAGIC);
+	output->writeInt(RawDataBlock::RAW_DATA_VERSION);
 
+	//reserve space for metadata
 	output->writeFloat(0); //totalTime
 	output->writeInt(0); //total Num Universes
 	output->writeInt(0); //num written frames
@@ -107,14 +114,60 @@ void RawDataLayer::recordOneFrame()
 	int numUniverses = 0;
 	MemoryBlock b;
 	MemoryOutputStream os(b, false);
+	MemoryOutputStream indexEntries;
 
+	const int64 dataStart = output->getPosition() + 8; //after time and numUniverses
+	const bool compress = compressRecording->boolValue();
 
-	for (auto& u : universes)
+	for (int i = 0; i < universes.size(); i++)
 	{
+		DMXUniverse* u = universes[i];
 		if (!u->isDirty) continue;
-		os.writeInt(u->getUniverseIndex());
-		os.write(u->values.getRawDataPointer(), DMX_NUM_CHANNELS);
+
+		//universes don't get dirty in index order, slots are kept by universe index
+		while (recordedUniverses.size() <= i) recordedUniverses.add(nullptr);
+		while (framesSinceKeyFrame.size() <= i) framesSinceKeyFrame.add(-1); //first write is always full
+		if (recordedUniverses[i] == nullptr) recordedUniverses.set(i, new DMXUniverse(u));
+
+		//the input thread keeps writing the universe, so everything below works on one snapshot.
+		//Cleared before copying, a change landing during the copy is recorded again next frame
 		u->isDirty = false;
+		uint8 values[DMX_NUM_CHANNELS];
+		memcpy(values, u->values.getRawDataPointer(), DMX_NUM_CHANNELS);
+
+		uint8* lastValues = recordedUniverses[i]->values.getRawDataPointer();
+
+		int numChanges = 0;
+		for (int c = 0; c < DMX_NUM_CHANNELS; c++) if (values[c] != lastValues[c]) numChanges++;
+
+		int& sinceKey = framesSinceKeyFrame.getReference(i);
+		bool writeDelta = compress && sinceKey >= 0 && sinceKey < RawDataBlock::RAW_DATA_KEYFRAME_INTERVAL && 2 + numChanges * 3 < DMX_NUM_CHANNELS;
+
+		os.writeInt(u->getUniverseIndex());
+		os.writeByte(writeDelta ? RawDataBlock::DELTA_DATA : RawDataBlock::FULL_DATA);
+
+		indexEntries.writeInt(u->getUniverseIndex());
+		indexEntries.writeInt64(dataStart + os.getPosition());
+		indexEntries.writeByte(writeDelta ? RawDataBlock::DELTA_DATA : RawDataBlock::FULL_DATA);
+
+		if (writeDelta)
+		{
+			os.writeShort((short)numChanges);
+			for (int c = 0; c < DMX_NUM_CHANNELS; c++)
+			{
+				if (values[c] == lastValues[c]) continue;
+				os.writeShort((short)c);
+				os.writeByte((char)values[c]);
+			}
+			sinceKey++;
+		}
+		else
+		{
+			os.write(values, DMX_NUM_CHANNELS);
+			sinceKey = 0;
+		}
+
+		memcpy(lastValues, values, DMX_NUM_CHANNELS);
 		numUniverses++;
 	}
 
@@ -122,16 +175,17 @@ void RawDataLayer::recordOneFrame()
 
 	if (numUniverses == 0) return;
 
-	int dataSize = b.getSize(); // +4 + 4;//including curTime and numUniverses, not including packetSize part
-
 	if (timeAtRecord == -1) timeAtRecord = sequence->currentTime->floatValue();
 	float time = sequence->currentTime->floatValue() - timeAtRecord;
 
-	output->writeInt(dataSize);
 	output->writeFloat(time);
 	output->writeInt(numUniverses);
 	output->write(b.getData(), b.getSize());
 
+	recordIndex.writeFloat(time);
+	recordIndex.writeInt(numUniverses);
+	recordIndex.write(indexEntries.getData(), indexEntries.getDataSize());
+
 	numWrittenFrames++;
 }
 
@@ -148,7 +202,15 @@ void RawDataLayer::stopRecording()
 		return;
 	}
 
-	output->setPosition(0);
+	//index and footer, allowing to open the file without reading all frames
+	int64 indexPos = output->getPosition();
+	output->write(recordIndex.getData(), recordIndex.getDataSize());
+	output->writeInt64(indexPos);
+	output->writeInt(numWrittenFrames);
+	output->writeInt(RawDataBlock::RAW_DATA_MAGIC);
+	recordIndex.reset();
+
+	output->setPosition(8); //after magic and version
 	output->writeFloat(sequence->currentTime->floatValue() - timeAtRecord); //totalTime
 	output->writeInt(universes.size()); //total Num Universes
 	output->writeInt(numWrittenFrames); //num written frames
@@ -209,19 +271,19 @@ void RawDataLayer::sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool)
 		}
 
 		GenericScopedLock fLock(frameUniverses.getLock());
-		frameUniverses.clear(); //only clear if block found, then when no block found, frameUniverses will keep memory of universes to send black to
+		//only refilled if block found, then when no block found, frameUniverses will keep memory of universes to send black to
 
 		if (s->isSeeking || prevTime > s->currentTime->floatValue()) needsToSendAllUniverses = true;
 
 		if (needsToSendAllUniverses)
 		{
 			//LOG("Read All Universes");
-			frameUniverses.addArray(rb->readAllUniversesAtTime(seqTime));
+			numFrameUniverses = rb->readAllUniversesAtTime(seqTime, frameUniverses);
 			needsToSendAllUniverses = false;
 		}
 		else
 		{
-			frameUniverses.addArray(rb->readFrameAtTime(seqTime));
+			numFrameUniverses = rb->readFrameAtTime(seqTime, frameUniverses);
 		}
 	}
 	else
@@ -289,8 +351,9 @@ void RawDataLayer::processRawData()
 
 	{
 		GenericScopedLock fLock(frameUniverses.getLock());
-		for (auto& u : frameUniverses)
+		for (int ui = 0; ui < numFrameUniverses; ui++)
 		{
+			DMXUniverse* u = frameUniverses.getUnchecked(ui);
 			DMXUniverse* interfaceU = dmxInterface->getUniverse(u->net, u->subnet, u->universe); //will force creation of the universe if doesn't exist
 
 			{
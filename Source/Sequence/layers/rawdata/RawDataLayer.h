@@ -28,6 +28,7 @@ public:
 	enum FrameSendMode { ALL, ACTIVE, ACTIVE_AND_SEEK };
 	EnumParameter* frameSendMode;
 	BoolParameter* forceResetValues;
+	BoolParameter* compressRecording;
 
 	File recordingFile;
 	std::unique_ptr<FileOutputStream> output;
@@ -45,7 +46,13 @@ public:
 	int numWrittenFrames;
 	DMXInterface* dmxInterface;
 
-	OwnedArray<DMXUniverse, CriticalSection> frameUniverses; //the one that will be copied to interface
+	//recording, last written values and frames since last full write, in the same order as universes
+	OwnedArray<DMXUniverse> recordedUniverses;
+	Array<int> framesSinceKeyFrame;
+	MemoryOutputStream recordIndex; //written at the end of the file when recording stops
+
+	OwnedArray<DMXUniverse, CriticalSection> frameUniverses; //the one that will be copied to interface, universe objects are reused between frames
+	int numFrameUniverses; //number of universes of frameUniverses filled for the current frame
 
 	void onContainerParameterChangedInternal(Parameter* p) override;
 